@@ -102,6 +102,7 @@ set(CGAMELIST
     ${GAMELOGIC_DIR}/cgame/cg_gameinfo.cpp
     ${GAMELOGIC_DIR}/cgame/cg_key_name.cpp
     ${GAMELOGIC_DIR}/cgame/cg_key_name.h
+    ${GAMELOGIC_DIR}/cgame/cg_lightprobes.cpp
     ${GAMELOGIC_DIR}/cgame/cg_local.h
     ${GAMELOGIC_DIR}/cgame/cg_main.cpp
     ${GAMELOGIC_DIR}/cgame/cg_marks.cpp
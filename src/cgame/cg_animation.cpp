@@ -165,6 +165,125 @@ void CG_BlendLerpFrame( lerpFrame_t *lf )
 	}
 }
 
+static Cvar::Range<Cvar::Cvar<int>> cg_poseCacheLerpSteps(
+	"cg_poseCacheLerpSteps", "share skeletons between models posed alike this frame, "
+	"rounding the lerp between frames to this many steps (0 = off)",
+	Cvar::NONE, 32, 0, 1024 );
+
+// must be a power of two
+#define POSE_CACHE_SIZE 64
+
+struct poseCacheEntry_t
+{
+	int           clientFrame; // entries from older frames are treated as empty
+	qhandle_t     animation;
+	int           startFrame;
+	int           endFrame;
+	int           lerpStep;
+	bool          clearOrigin;
+	bool          built;
+	refSkeleton_t skeleton;
+};
+
+static poseCacheEntry_t poseCache[ POSE_CACHE_SIZE ];
+
+static int poseCacheLookups = 0;
+static int poseCacheHits = 0;
+static int poseCacheStatsFrame = 0;
+
+/*
+===============
+CG_CopySkeleton
+
+Copies only the bones in use
+===============
+*/
+static void CG_CopySkeleton( refSkeleton_t *to, const refSkeleton_t *from )
+{
+	int numBones = Math::Clamp( from->numBones, 0, MAX_BONES );
+
+	memcpy( to, from, offsetof( refSkeleton_t, bones ) + numBones * sizeof( refBone_t ) );
+}
+
+/*
+===============
+CG_BuildSkeleton
+
+Same as trap_R_BuildSkeleton, but builds each distinct pose only once per
+frame. Idle buildables and standing players are usually posed alike, so
+the lerp between frames is rounded to cg_poseCacheLerpSteps steps and the
+first skeleton built for a pose is copied to the others.
+===============
+*/
+bool CG_BuildSkeleton( refSkeleton_t *skel, qhandle_t animation, int startFrame, int endFrame, float frac, bool clearOrigin )
+{
+	int              steps = cg_poseCacheLerpSteps.Get();
+	int              lerpStep;
+	unsigned         hash;
+	poseCacheEntry_t *entry;
+
+	if ( !steps )
+	{
+		return trap_R_BuildSkeleton( skel, animation, startFrame, endFrame, frac, clearOrigin );
+	}
+
+	lerpStep = Math::Clamp( ( int ) roundf( frac * steps ), 0, steps );
+
+	hash = ( unsigned ) animation * 73856093u ^ ( unsigned ) startFrame * 19349663u ^
+	       ( unsigned ) endFrame * 83492791u ^ ( unsigned ) lerpStep * 2654435761u ^ clearOrigin;
+	entry = &poseCache[ hash & ( POSE_CACHE_SIZE - 1 ) ];
+
+	poseCacheLookups++;
+
+	if ( entry->clientFrame == cg.clientFrame && entry->animation == animation &&
+	     entry->startFrame == startFrame && entry->endFrame == endFrame &&
+	     entry->lerpStep == lerpStep && entry->clearOrigin == clearOrigin )
+	{
+		poseCacheHits++;
+		CG_CopySkeleton( skel, &entry->skeleton );
+		return entry->built;
+	}
+
+	entry->clientFrame = cg.clientFrame;
+	entry->animation = animation;
+	entry->startFrame = startFrame;
+	entry->endFrame = endFrame;
+	entry->lerpStep = lerpStep;
+	entry->clearOrigin = clearOrigin;
+	entry->built = trap_R_BuildSkeleton( &entry->skeleton, animation, startFrame, endFrame,
+	                                     ( float ) lerpStep / steps, clearOrigin );
+
+	CG_CopySkeleton( skel, &entry->skeleton );
+
+	return entry->built;
+}
+
+/*
+===============
+CG_PoseCacheStats_f
+
+Report how often skeletons were shared since the last report
+===============
+*/
+void CG_PoseCacheStats_f()
+{
+	int frames = std::max( 1, cg.clientFrame - poseCacheStatsFrame );
+
+	if ( !cg_poseCacheLerpSteps.Get() )
+	{
+		Log::Notice( "the pose cache is off, set cg_poseCacheLerpSteps to enable it" );
+	}
+
+	Log::Notice( "%d skeletons over %d frames, %.1f%% shared, %.1f built per frame",
+	             poseCacheLookups, frames,
+	             poseCacheLookups ? 100.0f * poseCacheHits / poseCacheLookups : 0.0f,
+	             ( float )( poseCacheLookups - poseCacheHits ) / frames );
+
+	poseCacheLookups = 0;
+	poseCacheHits = 0;
+	poseCacheStatsFrame = cg.clientFrame;
+}
+
 /*
 ===============
 CG_BuildAnimSkeleton
@@ -190,7 +309,7 @@ void CG_BuildAnimSkeleton( const lerpFrame_t *lf, refSkeleton_t *newSkeleton, co
 		return;
 	}
 
-	if ( !trap_R_BuildSkeleton( newSkeleton, lf->animation->handle, lf->oldFrame, lf->frame, 1 - lf->backlerp, lf->animation->clearOrigin ) )
+	if ( !CG_BuildSkeleton( newSkeleton, lf->animation->handle, lf->oldFrame, lf->frame, 1 - lf->backlerp, lf->animation->clearOrigin ) )
 	{
 		Log::Warn( "CG_BuildAnimSkeleton: Can't build skeleton" );
 	}
@@ -991,7 +991,8 @@ static void CG_BuildableAnimation( centity_t *cent, int *old, int *now, float *b
 		*backLerp = cent->lerpFrame.backlerp;
 	}
 
-	if ( cg_buildables[ BG_Buildable( cent->currentState.modelindex )->number ].md5 )
+	// nobody sees the pose of a buildable out of view
+	if ( cg_buildables[ BG_Buildable( cent->currentState.modelindex )->number ].md5 && !cent->culled )
 	{
 		CG_BlendLerpFrame( lf );
 
@@ -1154,7 +1155,7 @@ void CG_GhostBuildable( int buildableInfo )
 
 	if ( cg_buildables[ buildable ].md5 )
 	{
-		trap_R_BuildSkeleton( &ent.skeleton, cg_buildables[ buildable ].animations[ BANIM_IDLE1 ].handle, 0, 0, 0, false );
+		CG_BuildSkeleton( &ent.skeleton, cg_buildables[ buildable ].animations[ BANIM_IDLE1 ].handle, 0, 0, 0, false );
 		CG_TransformSkeleton( &ent.skeleton, scale );
 	}
 
@@ -1961,10 +1962,9 @@ void CG_Buildable( centity_t *cent )
 	vec3_t        refNormal = { 0.0f, 0.0f, 1.0f };
 	float         scale;
 	int           health = CG_Health(cent);
-	buildable_t   buildable = (buildable_t)es->modelindex;
-	const buildableAttributes_t  *ba  = BG_Buildable( buildable );
-	const buildableModelConfig_t *bmc = BG_BuildableModelConfig( buildable );
-	team_t        team = ba->team;
+	const renderCache_t          *rc  = CG_RenderCache( cent );
+	const buildableAttributes_t  *ba  = rc->buildable;
+	team_t        team = rc->team;
 
 	//must be before EF_NODRAW check
 	if ( team == TEAM_ALIENS )
@@ -1992,7 +1992,8 @@ void CG_Buildable( centity_t *cent )
 
 	VectorCopy( es->origin2, surfNormal );
 
-	BG_BuildableBoundingBox( es->modelindex, mins, maxs );
+	VectorCopy( rc->mins, mins );
+	VectorCopy( rc->maxs, maxs );
 
 	if ( es->pos.trType == trType_t::TR_STATIONARY )
 	{
@@ -2035,12 +2036,12 @@ void CG_Buildable( centity_t *cent )
 	}
 
 	//offset on the Z axis if required
-	VectorMA( ent.origin, bmc->zOffset, surfNormal, ent.origin );
+	VectorMA( ent.origin, rc->zOffset, surfNormal, ent.origin );
 
 	VectorCopy( ent.origin, ent.oldorigin );  // don't positionally lerp at all
 	VectorCopy( ent.origin, ent.lightingOrigin );
 
-	ent.hModel = cg_buildables[ es->modelindex ].models[ 0 ];
+	ent.hModel = rc->hModel;
 	ent.shaderTime = float(double(cent->currentState.time) * 0.001);
 
 	if ( !( es->eFlags & EF_B_SPAWNED ) )
@@ -2070,20 +2071,17 @@ void CG_Buildable( centity_t *cent )
 	// Apply rotation from config.
 	{
 		matrix_t axisMat;
-		quat_t   axisQuat, rotQuat;
-
-		QuatFromAngles( rotQuat, bmc->modelRotation[ PITCH ], bmc->modelRotation[ YAW ],
-		                bmc->modelRotation[ ROLL ] );
+		quat_t   axisQuat;
 
 		MatrixFromVectorsFLU( axisMat, ent.axis[ 0 ], ent.axis[ 1 ], ent.axis[ 2 ] );
 		QuatFromMatrix( axisQuat, axisMat );
-		QuatMultiply2( axisQuat, rotQuat );
+		QuatMultiply2( axisQuat, rc->modelRotation );
 		MatrixFromQuat( axisMat, axisQuat );
 		MatrixToVectorsFLU( axisMat, ent.axis[ 0 ], ent.axis[ 1 ], ent.axis[ 2 ] );
 	}
 
 	// Apply scale from config.
-	scale = bmc->modelScale;
+	scale = rc->modelScale;
 
 	if ( scale != 1.0f )
 	{
@@ -2110,7 +2108,7 @@ void CG_Buildable( centity_t *cent )
 	}
 
 	// TODO: Rename condition as this is true for iqm models, too.
-	if ( cg_buildables[ es->modelindex ].md5 )
+	if ( rc->skeletal && !cent->culled )
 	{
 		// If buildable has spawned or is a human buildable, don't alter the size
 		bool  spawned = ( es->eFlags & EF_B_SPAWNED ) || ( team == TEAM_HUMANS );
@@ -2244,7 +2242,10 @@ void CG_Buildable( centity_t *cent )
 
 
 	// add to refresh list
-	trap_R_AddRefEntityToScene( &ent );
+	if ( !cent->culled )
+	{
+		trap_R_AddRefEntityToScene( &ent );
+	}
 
 	CrossProduct( surfNormal, refNormal, xNormal );
 	VectorNormalize( xNormal );
@@ -2264,9 +2265,9 @@ void CG_Buildable( centity_t *cent )
 			}
 
 			// update muzzle ps position
-			if ( CG_IsParticleSystemValid( &cent->muzzlePS ) )
+			if ( CG_IsParticleSystemValid( &cent->muzzlePS ) && !cent->culled )
 			{
-				if ( cg_buildables[ es->modelindex ].md5 )
+				if ( rc->skeletal )
 				{
 					switch ( es->modelindex )
 					{
@@ -2297,7 +2298,8 @@ void CG_Buildable( centity_t *cent )
 		// dynamic light
 		if ( cg.time - cent->muzzleFlashTime < MUZZLE_FLASH_TIME )
 		{
-			if ( wi->wim[ WPM_PRIMARY ].flashDlight )
+			if ( wi->wim[ WPM_PRIMARY ].flashDlight &&
+			     !CG_CullPointAndRadius( cent->lerpOrigin, wi->wim[ WPM_PRIMARY ].flashDlight ) )
 			{
 				trap_R_AddLightToScene( cent->lerpOrigin, wi->wim[ WPM_PRIMARY ].flashDlight,
 				                        wi->wim[ WPM_PRIMARY ].flashDlightIntensity,
@@ -2350,7 +2352,10 @@ void CG_Buildable( centity_t *cent )
 	CG_OnFire( cent );
 
 	// smoke etc for damaged buildables
-	CG_BuildableParticleEffects( cent );
+	if ( !cent->culled )
+	{
+		CG_BuildableParticleEffects( cent );
+	}
 
 	// draw range marker if enabled
 	if( team == CG_MyTeam() ) {
@@ -28,6 +28,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 // executed by a key binding
 
 #include "cg_local.h"
+#include "shared/parse.h"
 
 /*
 =================
@@ -366,6 +367,173 @@ static void CG_TestCGrade_f()
 	cgs.gameGradingModels[ 0 ] = -1;
 }
 
+struct benchmarkToken_t
+{
+	tokenType_t type;
+	int         subtype;
+	int         intvalue;
+	float       floatvalue;
+	int         line;
+	std::string string;
+};
+
+static void CG_ReadTokenStream( const char *filename, std::vector<benchmarkToken_t> &tokens )
+{
+	pc_token_t token;
+	int        handle = Parse_LoadSourceHandle( filename, trap_FS_OpenPakFile );
+
+	tokens.clear();
+
+	if ( !handle )
+	{
+		return;
+	}
+
+	while ( Parse_ReadTokenHandle( handle, &token ) )
+	{
+		tokens.push_back( { token.type, token.subtype, token.intvalue, token.floatvalue, token.line, token.string } );
+	}
+
+	Parse_FreeSourceHandle( handle );
+}
+
+/*
+=================
+CG_CheckTokenStream
+
+Reads a file with pooled tokens and with the one by one token
+allocation they replaced, and reports where the two streams differ
+=================
+*/
+static bool CG_CheckTokenStream( const char *name )
+{
+	std::string                   filename = name;
+	std::vector<benchmarkToken_t> reference, pooled;
+
+	if ( !Parse_SetReferenceTokens( true ) )
+	{
+		Log::Warn( "parseBenchmark: tokens are in use, %s is not checked", filename.c_str() );
+		return true;
+	}
+
+	CG_ReadTokenStream( filename.c_str(), reference );
+	Parse_SetReferenceTokens( false );
+	CG_ReadTokenStream( filename.c_str(), pooled );
+
+	for ( size_t i = 0; i < std::max( reference.size(), pooled.size() ); i++ )
+	{
+		if ( i >= reference.size() || i >= pooled.size() )
+		{
+			Log::Warn( "parseBenchmark: %s has %d tokens, %d without pooling",
+			           filename.c_str(), (int) pooled.size(), (int) reference.size() );
+			return false;
+		}
+
+		const benchmarkToken_t &a = pooled[ i ];
+		const benchmarkToken_t &b = reference[ i ];
+
+		if ( a.type != b.type || a.subtype != b.subtype || a.intvalue != b.intvalue ||
+		     a.floatvalue != b.floatvalue || a.line != b.line || a.string != b.string )
+		{
+			Log::Warn( "parseBenchmark: %s line %d: token %d is \"%s\", \"%s\" without pooling",
+			           filename.c_str(), b.line, (int) i, a.string.c_str(), b.string.c_str() );
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+=================
+CG_ParseBenchmark_f
+
+Reads every behavior tree, voice and ui config through the script
+preprocessor a number of times and reports the token throughput. Each
+file is first checked against the unpooled token path, and the checksum
+covers the whole token stream, so it can be compared between builds.
+=================
+*/
+static void CG_ParseBenchmark_f()
+{
+	static const struct
+	{
+		const char *dir;
+		const char *ext;
+	} sets[] = {
+		{ "bots",  ".bt"    },
+		{ "voice", ".voice" },
+		{ "ui",    ".cfg"   },
+	};
+
+	int iterations = 10;
+
+	if ( trap_Argc() > 1 )
+	{
+		iterations = std::max( 1, atoi( CG_Argv( 1 ) ) );
+	}
+
+	for ( const auto &set : sets )
+	{
+		char     fileList[ 8192 ];
+		int      numFiles = trap_FS_GetFileList( set.dir, set.ext, fileList, sizeof( fileList ) );
+		int      tokens = 0;
+		int      mismatches = 0;
+		uint32_t checksum = BG_HASH_INIT;
+		int      startTime;
+		char     *checked = fileList;
+
+		for ( int j = 0; j < numFiles; j++, checked += strlen( checked ) + 1 )
+		{
+			if ( !CG_CheckTokenStream( va( "%s/%s", set.dir, checked ) ) )
+			{
+				mismatches++;
+			}
+		}
+
+		startTime = trap_Milliseconds();
+
+		for ( int i = 0; i < iterations; i++ )
+		{
+			const char *file = fileList;
+
+			for ( int j = 0; j < numFiles; j++, file += strlen( file ) + 1 )
+			{
+				pc_token_t token;
+				int        handle = Parse_LoadSourceHandle( va( "%s/%s", set.dir, file ), trap_FS_OpenPakFile );
+
+				if ( !handle )
+				{
+					continue;
+				}
+
+				while ( Parse_ReadTokenHandle( handle, &token ) )
+				{
+					int type = Util::ordinal( token.type );
+
+					checksum = BG_HashBytes( checksum, &type, sizeof( type ) );
+					checksum = BG_HashBytes( checksum, &token.subtype, sizeof( token.subtype ) );
+					checksum = BG_HashBytes( checksum, token.string, strlen( token.string ) );
+
+					tokens++;
+				}
+
+				Parse_FreeSourceHandle( handle );
+			}
+		}
+
+		Log::Notice( "%s/*%s: %d files, %d tokens in %d msec, checksum %08x",
+		             set.dir, set.ext, numFiles, tokens / iterations,
+		             trap_Milliseconds() - startTime, checksum );
+
+		if ( mismatches )
+		{
+			Log::Warn( "parseBenchmark: %d %s/*%s files FAILED, pooled tokens differ from the unpooled parse",
+			           mismatches, set.dir, set.ext );
+		}
+	}
+}
+
 static void CG_MessageAdmin_f()
 {
 	cg.sayType = SAY_TYPE_ADMIN;
@@ -477,11 +645,13 @@ static const struct
 	{ "itemtoggle",       0,                       CG_CompleteItem  },
 	{ "kill",             0,                       0                },
 	{ "lcp",              CG_CenterPrint_f,        0                },
+	{ "lightProbeStats",  CG_LightProbeStats_f,    0                },
 	{ "listmaps",         0,                       0                },
 	{ "listrotation",     0,                       0                },
 	{ "luarocket",        Rocket_Lua_f,            0                },
 	{ "m",                0,                       CG_CompleteName  },
 	{ "maplog",           0,                       0                },
+	{ "markStats",        CG_MarkStats_f,          0                },
 	{ "me",               0,                       0                },
 	{ "message_admin",    CG_MessageAdmin_f,       0                },
 	{ "message_command",  CG_MessageCommand_f,     0                },
@@ -495,6 +665,10 @@ static const struct
 	{ "nextskin",         CG_TestModelNextSkin_f,  0                },
 	{ "noclip",           0,                       0                },
 	{ "notarget",         0,                       0                },
+	{ "parseBenchmark",   CG_ParseBenchmark_f,     0                },
+	{ "particleBenchmark", CG_ParticleBenchmark_f, 0                },
+	{ "poseCacheStats",   CG_PoseCacheStats_f,     0                },
+	{ "predictionBenchmark", CG_PredictionBenchmark_f, 0             },
 	{ "prevframe",        CG_TestModelPrevFrame_f, 0                },
 	{ "prevskin",         CG_TestModelPrevSkin_f,  0                },
 	{ "print_momentum",   0,                       0                },
@@ -502,6 +676,8 @@ static const struct
 	{ "reloadHud",        CG_ReloadHud_f,          0                },
 	{ "rocket",           Rocket_Rocket_f,         0,               },
 	{ "rocketDebug",      Rocket_RocketDebug_f,    0,               },
+	{ "rocketGeometryStats", Rocket_GeometryStats_f, 0,             },
+	{ "rocketQuakeToRMLBenchmark", Rocket_QuakeToRMLBenchmark_f, 0, },
 	{ "saveviewpos",      CG_SaveViewpos_f,        0                },
 	{ "say",              0,                       0                },
 	{ "say_area",         0,                       0                },
@@ -520,6 +696,7 @@ static const struct
 	{ "testPS",           CG_TestPS_f,             0                },
 	{ "testTS",           CG_TestTS_f,             0                },
 	{ "toggleMenu",       CG_ToggleMenu_f,         0                },
+	{ "translationStats", Trans_Stats_f,           0                },
 	{ "unignore",         0,                       CG_CompleteName  },
 	{ "updatelanguage",   Trans_UpdateLanguage_f,  0                },
 	{ "viewpos",          CG_Viewpos_f,            0                },
@@ -33,6 +33,12 @@ static Cvar::Range<Cvar::Cvar<float>>
 			"yourself to give an idea of distances. Set this "
 			"to 0 to disable", Cvar::CHEAT, 0.0f, 0.0f,
 			5000.0f);
+static Cvar::Range<Cvar::Cvar<int>> cg_cullEntities(
+	"cg_cullEntities", "skip drawing work for entities out of view: "
+	"0 off, 1 frustum, 2 frustum and PVS", Cvar::NONE, 1, 0, 2 );
+static Cvar::Range<Cvar::Cvar<int>> cg_cullEntityMargin(
+	"cg_cullEntityMargin", "how far out of view an entity still counts as "
+	"visible, for its shadow and attachments", Cvar::NONE, 32, 0, 512 );
 
 /*
 ======================
@@ -395,13 +401,13 @@ static void CG_Missile( centity_t *cent )
 	const missileAttributes_t *ma;
 
 	es = &cent->currentState;
-	ma = BG_Missile( es->weapon );
+	ma = CG_RenderCache( cent )->missile;
 
 	// calculate the axis
 	VectorCopy( es->angles, cent->lerpAngles );
 
 	// add dynamic light
-	if ( ma->usesDlight )
+	if ( ma->usesDlight && !CG_CullPointAndRadius( cent->lerpOrigin, ma->dlight ) )
 	{
 		trap_R_AddLightToScene( cent->lerpOrigin, ma->dlight, ma->dlightIntensity,
 		                        ma->dlightColor[ 0 ], ma->dlightColor[ 1 ], ma->dlightColor[ 2 ], 0, 0 );
@@ -430,7 +436,7 @@ static void CG_Missile( centity_t *cent )
 		ent.customShader = ma->sprite;
 		ent.shaderRGBA = Color::White;
 	}
-	else if ( ma->model )
+	else if ( ma->model && !cent->culled )
 	{
 		vec3_t velocity;
 
@@ -563,7 +569,7 @@ static void CG_Missile( centity_t *cent )
 	}
 
 	// Only refresh if there is something to display.
-	if ( ma->sprite || ma->model )
+	if ( ( ma->sprite || ma->model ) && !cent->culled )
 	{
 		trap_R_AddRefEntityToScene( &ent );
 	}
@@ -889,11 +895,24 @@ CG_AdjustPositionForMover
 Also called by client movement prediction code
 =========================
 */
+struct moverDelta_t
+{
+	int    clientFrame;
+	int    serverTime;
+	int    fromTime;
+	int    toTime;
+	vec3_t origin;
+	vec3_t angles;
+};
+
+// how far each mover moved between two times, kept for the frame since
+// everything riding a mover asks for the same times
+static moverDelta_t moverDeltas[ ENTITYNUM_MAX_NORMAL ];
+
 void CG_AdjustPositionForMover( const vec3_t in, int moverNum, int fromTime, int toTime, vec3_t out, vec3_t angles_in, vec3_t angles_out )
 {
-	centity_t *cent;
-	vec3_t    oldOrigin, origin, deltaOrigin;
-	vec3_t    oldAngles, angles, deltaAngles;
+	centity_t    *cent;
+	moverDelta_t *delta;
 
 	if ( moverNum <= 0 || moverNum >= ENTITYNUM_MAX_NORMAL )
 	{
@@ -911,17 +930,31 @@ void CG_AdjustPositionForMover( const vec3_t in, int moverNum, int fromTime, int
 		return;
 	}
 
-	BG_EvaluateTrajectory( &cent->currentState.pos, fromTime, oldOrigin );
-	BG_EvaluateTrajectory( &cent->currentState.apos, fromTime, oldAngles );
+	delta = &moverDeltas[ moverNum ];
+
+	if ( delta->clientFrame != cg.clientFrame || delta->serverTime != cg.snap->serverTime ||
+	     delta->fromTime != fromTime || delta->toTime != toTime )
+	{
+		vec3_t oldOrigin, origin;
+		vec3_t oldAngles, angles;
+
+		BG_EvaluateTrajectory( &cent->currentState.pos, fromTime, oldOrigin );
+		BG_EvaluateTrajectory( &cent->currentState.apos, fromTime, oldAngles );
 
-	BG_EvaluateTrajectory( &cent->currentState.pos, toTime, origin );
-	BG_EvaluateTrajectory( &cent->currentState.apos, toTime, angles );
+		BG_EvaluateTrajectory( &cent->currentState.pos, toTime, origin );
+		BG_EvaluateTrajectory( &cent->currentState.apos, toTime, angles );
 
-	VectorSubtract( origin, oldOrigin, deltaOrigin );
-	VectorSubtract( angles, oldAngles, deltaAngles );
+		VectorSubtract( origin, oldOrigin, delta->origin );
+		VectorSubtract( angles, oldAngles, delta->angles );
 
-	VectorAdd( in, deltaOrigin, out );
-	VectorAdd( angles_in, deltaAngles, angles_out );
+		delta->clientFrame = cg.clientFrame;
+		delta->serverTime = cg.snap->serverTime;
+		delta->fromTime = fromTime;
+		delta->toTime = toTime;
+	}
+
+	VectorAdd( in, delta->origin, out );
+	VectorAdd( angles_in, delta->angles, angles_out );
 
 	// FIXME: origin change when on a rotating object
 }
@@ -973,6 +1006,12 @@ static void CG_CalcEntityLerpPositions( centity_t *cent )
 	// this will be set to how far forward projectiles will be extrapolated
 	int timeshift = 0;
 
+	// already placed with the rest of the snapshot
+	if ( cent->lerpPositionFrame == cg.clientFrame && cent != &cg.predictedPlayerEntity )
+	{
+		return;
+	}
+
 	// if this player does not want to see extrapolated players
 	if ( !cg_smoothClients.Get() )
 	{
@@ -1039,6 +1078,160 @@ static void CG_CalcEntityLerpPositions( centity_t *cent )
 	}
 }
 
+/*
+===============
+CG_CalcSnapshotLerpPositions
+
+Places every entity in the snapshot before any of them are added
+===============
+*/
+static void CG_CalcSnapshotLerpPositions()
+{
+	for ( const entityState_t &es : cg.snap->entities )
+	{
+		centity_t *cent = &cg_entities[ es.number ];
+
+		if ( cent->currentState.eType >= entityType_t::ET_EVENTS )
+		{
+			continue;
+		}
+
+		CG_CalcEntityLerpPositions( cent );
+		cent->lerpPositionFrame = cg.clientFrame;
+	}
+}
+
+/*
+===============
+CG_RenderClass
+
+Players carry their class in misc, corpses in clientNum
+===============
+*/
+static class_t CG_RenderClass( const entityState_t *es )
+{
+	if ( es->eType == entityType_t::ET_CORPSE )
+	{
+		return (class_t) es->clientNum;
+	}
+
+	return (class_t) ( ( es->misc >> 8 ) & 0xFF );
+}
+
+/*
+===============
+CG_UpdateRenderCache
+
+Resolve everything about how an entity looks that only depends on what
+kind of entity it is
+===============
+*/
+static void CG_UpdateRenderCache( centity_t *cent )
+{
+	const entityState_t *es = &cent->currentState;
+	renderCache_t       *rc = &cent->renderCache;
+
+	*rc = {};
+
+	rc->eType = es->eType;
+	rc->modelindex = es->modelindex;
+	rc->clientNum = es->clientNum;
+	rc->weapon = es->weapon;
+	rc->class_ = CG_RenderClass( es );
+	rc->team = TEAM_NONE;
+	rc->modelScale = 1.0f;
+
+	switch ( es->eType )
+	{
+		case entityType_t::ET_BUILDABLE:
+			if ( es->modelindex < BA_NONE || es->modelindex >= BA_NUM_BUILDABLES )
+			{
+				break;
+			}
+
+			rc->buildable = BG_Buildable( es->modelindex );
+			rc->buildableModel = BG_BuildableModelConfig( es->modelindex );
+			rc->team = rc->buildable->team;
+			rc->hModel = cg_buildables[ es->modelindex ].models[ 0 ];
+			rc->skeletal = cg_buildables[ es->modelindex ].md5;
+			rc->modelScale = rc->buildableModel->modelScale;
+			rc->zOffset = rc->buildableModel->zOffset;
+
+			QuatFromAngles( rc->modelRotation, rc->buildableModel->modelRotation[ PITCH ],
+			                rc->buildableModel->modelRotation[ YAW ],
+			                rc->buildableModel->modelRotation[ ROLL ] );
+
+			BG_BuildableBoundingBox( es->modelindex, rc->mins, rc->maxs );
+			break;
+
+		case entityType_t::ET_PLAYER:
+		case entityType_t::ET_CORPSE:
+			if ( rc->class_ < PCL_NONE || rc->class_ >= PCL_NUM_CLASSES )
+			{
+				break;
+			}
+
+			rc->classModel = BG_ClassModelConfig( rc->class_ );
+			rc->team = BG_Class( rc->class_ )->team;
+			rc->modelScale = rc->classModel->modelScale;
+			rc->zOffset = rc->classModel->zOffset;
+
+			BG_ClassBoundingBox( rc->class_, rc->mins, rc->maxs, nullptr, nullptr, nullptr );
+			break;
+
+		case entityType_t::ET_MISSILE:
+			rc->missile = BG_Missile( es->weapon );
+			break;
+
+		default:
+			break;
+	}
+
+	rc->valid = true;
+}
+
+/*
+===============
+CG_CheckRenderCache
+
+Drop the render cache of an entity whose state no longer matches it
+===============
+*/
+void CG_CheckRenderCache( centity_t *cent )
+{
+	const entityState_t *es = &cent->currentState;
+	const renderCache_t *rc = &cent->renderCache;
+
+	if ( !rc->valid )
+	{
+		return;
+	}
+
+	if ( rc->eType != es->eType ||
+	     rc->modelindex != es->modelindex ||
+	     rc->clientNum != es->clientNum ||
+	     rc->weapon != es->weapon ||
+	     rc->class_ != CG_RenderClass( es ) )
+	{
+		cent->renderCache.valid = false;
+	}
+}
+
+/*
+===============
+CG_RenderCache
+===============
+*/
+const renderCache_t *CG_RenderCache( centity_t *cent )
+{
+	if ( !cent->renderCache.valid )
+	{
+		CG_UpdateRenderCache( cent );
+	}
+
+	return &cent->renderCache;
+}
+
 /*
 ===============
 CG_CEntityPVSEnter
@@ -1088,6 +1281,8 @@ static void CG_CEntityPVSEnter( centity_t *cent )
 	cent->oldBuildableAnim = (buildableAnimNumber_t) es.legsAnim;
 	cent->radarVisibility = 0.0f;
 
+	CG_UpdateRenderCache( cent );
+
 	cent->pvsEnterTime = cg.time;
 }
 
@@ -1263,6 +1458,99 @@ static void CG_AddCEntity( centity_t *cent )
 	}
 }
 
+/*
+===============
+CG_CullRadius
+
+Radius of a sphere around lerpOrigin that holds all of an entity's model
+===============
+*/
+static float CG_CullRadius( centity_t *cent )
+{
+	const renderCache_t *rc = CG_RenderCache( cent );
+	const entityState_t *es = &cent->currentState;
+	float               radius;
+
+	switch ( es->eType )
+	{
+		case entityType_t::ET_PLAYER:
+		case entityType_t::ET_CORPSE:
+		case entityType_t::ET_BUILDABLE:
+			radius = 0.0f;
+
+			for ( int i = 0; i < 3; i++ )
+			{
+				radius += Square( std::max( fabsf( rc->mins[ i ] ), fabsf( rc->maxs[ i ] ) ) );
+			}
+
+			return sqrtf( radius ) * std::max( rc->modelScale, 1.0f ) + fabsf( rc->zOffset );
+
+		case entityType_t::ET_MISSILE:
+			if ( rc->missile->usesSprite )
+			{
+				return rc->missile->spriteSize + rc->missile->spriteCharge * es->torsoAnim;
+			}
+
+			return rc->missile->size * std::max( rc->missile->modelScale, 1.0f );
+
+		default:
+			return -1.0f;
+	}
+}
+
+/*
+===============
+CG_CullPacketEntities
+
+Mark the snapshot entities that cannot be seen this frame, so that they
+only do what can be heard or what keeps their state going, and skip
+building skeletons and submitting models
+===============
+*/
+static void CG_CullPacketEntities()
+{
+	int mode = cg_cullEntities.Get();
+	int margin = cg_cullEntityMargin.Get();
+
+	for ( const entityState_t &es : cg.snap->entities )
+	{
+		centity_t *cent = &cg_entities[ es.number ];
+		float     radius;
+
+		cent->culled = false;
+
+		if ( !mode || cent->currentState.eType >= entityType_t::ET_EVENTS )
+		{
+			continue;
+		}
+
+		// only entities whose whole model is known are culled
+		radius = CG_CullRadius( cent );
+
+		if ( radius < 0.0f )
+		{
+			continue;
+		}
+
+		radius += margin;
+
+		if ( CG_CullPointAndRadius( cent->lerpOrigin, radius ) )
+		{
+			cent->culled = true;
+		}
+		else if ( mode > 1 && !trap_R_inPVS( cg.refdef.vieworg, cent->lerpOrigin ) )
+		{
+			vec3_t top;
+
+			// the origin can be just inside a wall, so try the top too
+			VectorCopy( cent->lerpOrigin, top );
+			top[ 2 ] += radius;
+
+			cent->culled = !trap_R_inPVS( cg.refdef.vieworg, top );
+		}
+	}
+}
+
 /*
 ===============
 CG_AddPacketEntities
@@ -1311,6 +1599,7 @@ void CG_AddPacketEntities()
 	// generate and add the entity from the playerstate
 	ps = &cg.predictedPlayerState;
 	BG_PlayerStateToEntityState( ps, &cg.predictedPlayerEntity.currentState, false );
+	CG_CheckRenderCache( &cg.predictedPlayerEntity );
 	cg.predictedPlayerEntity.valid = true;
 	CG_AddCEntity( &cg.predictedPlayerEntity );
 
@@ -1345,6 +1634,12 @@ void CG_AddPacketEntities()
 		cent->oldValid = cent->valid;
 	}
 
+	// place every entity sent over by the server
+	CG_CalcSnapshotLerpPositions();
+
+	// and find out which of them can be seen
+	CG_CullPacketEntities();
+
 	// add each entity sent over by the server
 	for ( unsigned num = 0; num < cg.snap->entities.size(); num++ )
 	{
@@ -0,0 +1,242 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2026 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+// cg_lightprobes.cpp -- cached ambient light samples for particles and trails
+
+#include "cg_local.h"
+
+static Cvar::Cvar<bool> cg_lightProbes(
+	"cg_lightProbes", "light particles and trails from a cache of ambient light samples",
+	Cvar::NONE, true );
+static Cvar::Range<Cvar::Cvar<int>> cg_lightProbeSpacing(
+	"cg_lightProbeSpacing", "distance between cached ambient light samples",
+	Cvar::NONE, 64, 16, 512 );
+
+// must be a power of two
+#define LIGHT_PROBE_HASH_SIZE 8192
+
+struct lightProbe_t
+{
+	int    generation;
+	int    cell[ 3 ];
+	vec3_t ambient;
+};
+
+static lightProbe_t lightProbes[ LIGHT_PROBE_HASH_SIZE ];
+
+// probes from an older generation are treated as empty
+static int lightProbeGeneration = 1;
+static int lightProbeSpacing = 0;
+
+static int lightProbeLookups = 0;
+static int lightProbeHits = 0;
+
+/*
+===============
+CG_InvalidateLightProbes
+
+Forget every cached sample, called whenever the world lighting changes
+===============
+*/
+void CG_InvalidateLightProbes()
+{
+	lightProbeGeneration++;
+	lightProbeSpacing = cg_lightProbeSpacing.Get();
+	lightProbeLookups = 0;
+	lightProbeHits = 0;
+}
+
+/*
+===============
+CG_LightProbe
+
+Find the sample at a grid corner, asking the renderer for it on a miss
+===============
+*/
+static const float *CG_LightProbe( int x, int y, int z )
+{
+	unsigned     hash;
+	lightProbe_t *probe;
+	vec3_t       point, directed, dir;
+
+	hash = ( unsigned ) x * 73856093u ^ ( unsigned ) y * 19349663u ^ ( unsigned ) z * 83492791u;
+	probe = &lightProbes[ hash & ( LIGHT_PROBE_HASH_SIZE - 1 ) ];
+
+	lightProbeLookups++;
+
+	if ( probe->generation == lightProbeGeneration &&
+	     probe->cell[ 0 ] == x && probe->cell[ 1 ] == y && probe->cell[ 2 ] == z )
+	{
+		lightProbeHits++;
+		return probe->ambient;
+	}
+
+	VectorSet( point, x * lightProbeSpacing, y * lightProbeSpacing, z * lightProbeSpacing );
+	trap_R_LightForPoint( point, probe->ambient, directed, dir );
+
+	probe->generation = lightProbeGeneration;
+	probe->cell[ 0 ] = x;
+	probe->cell[ 1 ] = y;
+	probe->cell[ 2 ] = z;
+
+	return probe->ambient;
+}
+
+/*
+===============
+CG_AmbientLightForPoint
+
+Trilinearly interpolate the ambient light at a point from the eight
+surrounding samples. Black samples usually sit inside solids, so like
+the renderer's light grid they are left out rather than darkening
+everything near a wall.
+===============
+*/
+void CG_AmbientLightForPoint( const vec3_t point, vec3_t ambient )
+{
+	vec3_t scaled, frac;
+	int    base[ 3 ];
+	float  totalWeight = 0.0f;
+
+	if ( !cg_lightProbes.Get() )
+	{
+		vec3_t origin, directed, dir;
+
+		VectorCopy( point, origin );
+		trap_R_LightForPoint( origin, ambient, directed, dir );
+		return;
+	}
+
+	if ( lightProbeSpacing != cg_lightProbeSpacing.Get() )
+	{
+		CG_InvalidateLightProbes();
+	}
+
+	VectorScale( point, 1.0f / lightProbeSpacing, scaled );
+
+	for ( int i = 0; i < 3; i++ )
+	{
+		base[ i ] = ( int ) floorf( scaled[ i ] );
+		frac[ i ] = scaled[ i ] - base[ i ];
+	}
+
+	VectorClear( ambient );
+
+	for ( int corner = 0; corner < 8; corner++ )
+	{
+		const float *sample;
+		float       weight = 1.0f;
+		int         cell[ 3 ];
+
+		for ( int i = 0; i < 3; i++ )
+		{
+			if ( corner & ( 1 << i ) )
+			{
+				cell[ i ] = base[ i ] + 1;
+				weight *= frac[ i ];
+			}
+			else
+			{
+				cell[ i ] = base[ i ];
+				weight *= 1.0f - frac[ i ];
+			}
+		}
+
+		if ( weight <= 0.0f )
+		{
+			continue;
+		}
+
+		sample = CG_LightProbe( cell[ 0 ], cell[ 1 ], cell[ 2 ] );
+
+		if ( sample[ 0 ] + sample[ 1 ] + sample[ 2 ] <= 0.0f )
+		{
+			continue;
+		}
+
+		VectorMA( ambient, weight, sample, ambient );
+		totalWeight += weight;
+	}
+
+	if ( totalWeight > 0.0f )
+	{
+		VectorScale( ambient, 1.0f / totalWeight, ambient );
+	}
+}
+
+/*
+===============
+CG_LightProbeStats_f
+
+Compare the cached lighting with the renderer's at random points around
+the view and report the cache hit rate
+===============
+*/
+void CG_LightProbeStats_f()
+{
+	int   samples = 256;
+	int   tested = 0;
+	float totalError = 0.0f, maxError = 0.0f;
+
+	if ( trap_Argc() > 1 )
+	{
+		samples = std::max( 1, atoi( CG_Argv( 1 ) ) );
+	}
+
+	Log::Notice( "%d light probe lookups since the last flush, %.1f%% hits",
+	             lightProbeLookups,
+	             lightProbeLookups ? 100.0f * lightProbeHits / lightProbeLookups : 0.0f );
+
+	for ( int i = 0; i < samples; i++ )
+	{
+		vec3_t point, exact, cached, directed, dir;
+		float  error = 0.0f;
+
+		VectorSet( point, crandom(), crandom(), crandom() );
+		VectorMA( cg.refdef.vieworg, 1024.0f, point, point );
+
+		if ( CM_PointContents( point, 0 ) & CONTENTS_SOLID )
+		{
+			continue;
+		}
+
+		trap_R_LightForPoint( point, exact, directed, dir );
+		CG_AmbientLightForPoint( point, cached );
+
+		for ( int j = 0; j < 3; j++ )
+		{
+			error = std::max( error, fabsf( exact[ j ] - cached[ j ] ) );
+		}
+
+		totalError += error;
+		maxError = std::max( maxError, error );
+		tested++;
+	}
+
+	if ( tested )
+	{
+		Log::Notice( "%d points within 1024 units of the view: mean error %.1f, max error %.1f (out of 255)",
+		             tested, totalError / tested, maxError );
+	}
+}
@@ -377,6 +377,12 @@ struct particleSystem_t
 	vec3_t   lastNormal;
 
 	int      charge;
+
+	//set by the particle budget scheduler every frame
+	float    importance;
+	bool     culled;
+	float    ejectionScale;
+	float    ejectionCredit;
 };
 
 struct particleEjector_t
@@ -448,7 +454,7 @@ struct particle_t
 
 #define MAX_TRAIL_SYSTEMS      50
 #define MAX_TRAIL_BEAMS        (MAX_TRAIL_SYSTEMS * MAX_BEAMS_PER_SYSTEM)
-#define MAX_TRAIL_BEAM_NODES   128
+#define MAX_TRAIL_BEAM_NODES   128 // must be a power of two
 
 #define MAX_TRAIL_BEAM_JITTERS 4
 
@@ -542,12 +548,6 @@ struct trailBeamNode_t
 	byte                   color[ 3 ];
 
 	vec2_t                 jitters[ MAX_TRAIL_BEAM_JITTERS ];
-
-	trailBeamNode_t *prev;
-
-	trailBeamNode_t *next;
-
-	bool               used;
 };
 
 struct trailBeam_t
@@ -555,8 +555,10 @@ struct trailBeam_t
 	baseTrailBeam_t   *class_;
 	trailSystem_t   *parent;
 
-	trailBeamNode_t nodePool[ MAX_TRAIL_BEAM_NODES ];
-	trailBeamNode_t *nodes;
+	//ring buffer of nodes from front to back, see CG_BeamNode
+	trailBeamNode_t nodes[ MAX_TRAIL_BEAM_NODES ];
+	int             firstNode;
+	int             numNodes;
 
 	int             lastEvalTime;
 
@@ -628,6 +630,54 @@ struct buildableCache_t
 	vec3_t origin;
 };
 
+// render state that only depends on what an entity is, not where it is or
+// what it is doing, so it is worked out when the entity enters the PVS and
+// again only when one of the fields it comes from changes
+struct renderCache_t
+{
+	bool                         valid;
+
+	// the entityState_t fields everything below comes from
+	entityType_t                 eType;
+	int                          modelindex;
+	int                          clientNum;
+	int                          weapon;
+	class_t                      class_;
+
+	team_t                       team;
+	vec3_t                       mins;
+	vec3_t                       maxs;
+
+	const buildableAttributes_t  *buildable;
+	const buildableModelConfig_t *buildableModel;
+	const classModelConfig_t     *classModel;
+	const missileAttributes_t    *missile;
+
+	qhandle_t                    hModel;
+	bool                         skeletal;
+	quat_t                       modelRotation;
+	float                        modelScale;
+	float                        zOffset;
+};
+
+// the last traces under a player for its shadow and wake, reused while it
+// stays near where they were made
+struct groundProbe_t
+{
+	int     shadowTime;
+	class_t shadowClass;
+	vec3_t  shadowOrigin;
+	vec3_t  shadowNormal;
+	trace_t shadowTrace;
+
+	int     splashTime;
+	class_t splashClass;
+	vec3_t  splashOrigin;
+	bool    splash;
+	vec3_t  splashPoint;
+	vec3_t  splashNormal;
+};
+
 //=================================================
 
 #define MAX_CBEACONS 50
@@ -754,6 +804,7 @@ struct centity_t
 	// exact interpolated position of entity on this frame
 	vec3_t                lerpOrigin;
 	vec3_t                lerpAngles;
+	int                   lerpPositionFrame; // cg.clientFrame they were last worked out for
 
 	lerpFrame_t           lerpFrame;
 
@@ -764,6 +815,8 @@ struct centity_t
 	particleSystem_t      *buildableStatusPS; // used for steady effects like fire
 	buildableStatus_t     buildableStatus;
 	buildableCache_t      buildableCache; // so we don't recalculate things
+	renderCache_t         renderCache;
+	groundProbe_t         groundProbe;
 	float                 lastBuildableHealth;
 	int                   lastBuildableDamageSoundTime;
 
@@ -800,6 +853,7 @@ struct centity_t
 
 	bool              valid;
 	bool              oldValid;
+	bool              culled; // entirely out of view this frame
 	int                   pvsEnterTime;
 
 	cbeacon_t             beacon;
@@ -812,9 +866,13 @@ struct centity_t
 
 //======================================================================
 
+//the impact a mark poly was clipped from, private to cg_marks.cpp
+struct markImpact_t;
+
 struct markPoly_t
 {
 	markPoly_t *prevMark, *nextMark;
+	markImpact_t      *impact;
 
 	int               time;
 	qhandle_t         markShader;
@@ -1035,6 +1093,18 @@ struct minimap_t
 
 #define NUM_SAVED_STATES         ( CMD_BACKUP + 2 )
 
+#define MAX_PREDICTION_TOUCHES   32
+
+// inputs of a predicted command that decide whether its saved result can be
+// reused; the playerState it started from is the result of the previous one
+struct predictionInputs_t
+{
+	uint32_t cmdHash;    // usercmd and trace mask
+	int      numTouched; // -1 if too many entities were touched to track them
+	int      touched[ MAX_PREDICTION_TOUCHES ];
+	uint32_t touchHash;  // state of the touched solid entities
+};
+
 // After this many msec the crosshair name fades out completely
 #define CROSSHAIR_CLIENT_TIMEOUT 1000
 
@@ -1243,6 +1313,7 @@ struct cg_t
 	int                     lastPredictedCommand;
 	int                     lastServerTime;
 	playerState_t           savedPmoveStates[ NUM_SAVED_STATES ];
+	predictionInputs_t      savedPmoveInputs[ NUM_SAVED_STATES ];
 	int                     stateHead, stateTail;
 	int                     ping;
 
@@ -1340,6 +1411,24 @@ struct server_t
 	int maxClients;
 	char *mapName;
 	char *addr;
+
+	int lanIndex;
+	char *info; // as last read, to spot what changed
+
+	// lowercase and colour-stripped, for sorting and filtering
+	char *sortName;
+	char *sortMap;
+};
+
+enum serverSort_t
+{
+  SERVER_SORT_ARRIVAL,
+  SERVER_SORT_PING,
+  SERVER_SORT_NAME,
+  SERVER_SORT_MAP,
+  SERVER_SORT_PLAYERS,
+
+  SERVER_SORT_NUM
 };
 
 
@@ -1383,6 +1472,12 @@ struct rocketDataSource_t
 	server_t servers[ AS_NUM_TYPES ][ MAX_SERVERS ];
 	int serverCount[ AS_NUM_TYPES ];
 	int serverIndex[ AS_NUM_TYPES ];
+	std::vector<int> serverLanSlots[ AS_NUM_TYPES ];
+	int serverOrder[ AS_NUM_TYPES ][ SERVER_SORT_NUM ][ MAX_SERVERS ];
+	int serverSort[ AS_NUM_TYPES ];
+	char serverFilter[ AS_NUM_TYPES ][ MAX_INFO_VALUE ];
+	int serverRows[ AS_NUM_TYPES ][ MAX_SERVERS ];
+	int serverRowCount[ AS_NUM_TYPES ];
 	bool buildingServerInfo;
 	bool retrievingServers;
 
@@ -1980,6 +2075,9 @@ void        CG_ResetPlayerEntity( centity_t *cent );
 void        CG_NewClientInfo( int clientNum );
 
 void        CG_PrecacheClientInfo( class_t class_, const char *model, const char *skin );
+void        CG_QueueClientModel( const char *modelName, const char *skinName );
+void        CG_RunClientModelQueue();
+void        CG_ClientModelStats();
 sfxHandle_t CG_CustomSound( int clientNum, const char *soundName );
 void        CG_PlayerDisconnect( vec3_t org );
 centity_t   *CG_GetLocation( vec3_t );
@@ -2008,6 +2106,8 @@ int CG_AnimNumber( int anim );
 void CG_RunLerpFrame( lerpFrame_t *lf, float scale );
 void CG_RunMD5LerpFrame( lerpFrame_t *lf, float scale, bool animChanged );
 void CG_BlendLerpFrame( lerpFrame_t *lf );
+bool CG_BuildSkeleton( refSkeleton_t *skel, qhandle_t animation, int startFrame, int endFrame, float frac, bool clearOrigin );
+void CG_PoseCacheStats_f();
 void CG_BuildAnimSkeleton( const lerpFrame_t *lf, refSkeleton_t *newSkeleton, const refSkeleton_t *oldSkeleton );
 
 //
@@ -2030,6 +2130,7 @@ void CG_BiSphereTrace( trace_t *result, const vec3_t start, const vec3_t end,
                        const float startRadius, const float endRadius, int skipNumber, int mask,
                        int skipmask );
 void CG_PredictPlayerState();
+void CG_PredictionBenchmark_f();
 
 //
 // cg_events.c
@@ -2054,6 +2155,8 @@ void CG_PositionEntityOnTag( refEntity_t *entity, const refEntity_t *parent,
 void CG_PositionRotatedEntityOnTag( refEntity_t *entity, const refEntity_t *parent,
                                     qhandle_t parentModel, const char *tagName );
 void CG_TransformSkeleton( refSkeleton_t *skel, const vec_t scale );
+void CG_CheckRenderCache( centity_t *cent );
+const renderCache_t *CG_RenderCache( centity_t *cent );
 
 team_t CG_Team(const entityState_t &es);
 inline team_t CG_Team(const centity_t *ent) {
@@ -2112,6 +2215,8 @@ void CG_HandleMissileHitWall( entityState_t *es, vec3_t origin );
 
 void CG_AddViewWeapon( playerState_t *ps );
 void CG_AddPlayerWeapon( refEntity_t *parent, playerState_t *ps, centity_t *cent );
+void CG_AddPlayerWeaponSounds( playerState_t *ps, centity_t *cent );
+void CG_AddPlayerWeaponFlashLight( centity_t *cent, const vec3_t origin );
 void CG_DrawHumanInventory();
 float CG_ChargeProgress();
 
@@ -2121,17 +2226,28 @@ float CG_ChargeProgress();
 void CG_InitMinimap();
 void CG_DrawMinimap( const rectDef_t *rect, const Color::Color& color );
 
+//
+// cg_lightprobes.cpp
+//
+void CG_InvalidateLightProbes();
+void CG_AmbientLightForPoint( const vec3_t point, vec3_t ambient );
+void CG_LightProbeStats_f();
+
 //
 // cg_marks.c
 //
 void CG_InitMarkPolys();
 void CG_AddMarks();
+void CG_MarkStats_f();
 void CG_ImpactMark( qhandle_t markShader,
                     const vec3_t origin, const vec3_t dir,
                     float orientation,
                     float r, float g, float b, float a,
                     bool alphaFade,
                     float radius, bool temporary );
+void CG_GroundMark( qhandle_t markShader, const vec3_t origin, const vec3_t dir,
+                    float orientation, float r, float g, float b, float a,
+                    float radius );
 
 //
 // cg_snapshot.c
@@ -2208,6 +2324,7 @@ void             CG_ParticleSystemEntity( centity_t *cent );
 
 void             CG_TestPS_f();
 void             CG_DestroyTestPS_f();
+void             CG_ParticleBenchmark_f();
 
 //
 // cg_trails.c
@@ -2338,9 +2455,13 @@ void Rocket_DSAddRow( const char *name, const char *table, const char *data );
 void Rocket_DSChangeRow( const char *name, const char *table, const int row, const char *data );
 void Rocket_DSRemoveRow( const char *name, const char *table, const int row );
 void Rocket_DSClearTable( const char *name, const char *table );
+void Rocket_DSBeginTable( const char *name, const char *table );
+void Rocket_DSCommitTables();
 void Rocket_SetInnerRML( const char* text, int parseFlags );
 void Rocket_SetInnerRMLRaw( const char* RML );
 void Rocket_QuakeToRMLBuffer( const char *in, char *out, int length );
+void Rocket_ClearQuakeToRMLCache();
+void Rocket_QuakeToRMLBenchmark_f();
 void Rocket_GetEventParameters( char *params, int length );
 void Rocket_RegisterDataFormatter( const char *name );
 void Rocket_DataFormatterRawData( int handle, char *name, int nameLength, char *data, int dataLength );
@@ -2372,6 +2493,7 @@ void Rocket_LoadFont( const char *font );
 void Rocket_Rocket_f( void );
 void Rocket_Lua_f( void );
 void Rocket_RocketDebug_f();
+void Rocket_GeometryStats_f();
 void Rocket_UpdateLanguage();
 
 //
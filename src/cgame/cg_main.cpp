@@ -165,7 +165,7 @@ Cvar::Cvar<std::string> cg_sayCommand("cg_sayCommand", "instead of talking, chat
 // It's intended to aid developers who are frequently restarting the game.
 // In normal play, it would be undesirable as it causes lag when someone first uses a class.
 // TODO: only works for player models. Buildings and weapons are also relevant
-Cvar::Cvar<bool> cg_lazyLoadModels("cg_lazyLoadModels", "load models only when needed", Cvar::CHEAT, false);
+Cvar::Cvar<bool> cg_lazyLoadModels("cg_lazyLoadModels", "load models only when needed, or over several frames with cg_modelLoadBudget", Cvar::CHEAT, false);
 
 // USERINFO cvars - transmitted to the server
 static Cvar::Range<Cvar::Cvar<int>> cg_disableBlueprintErrors("cg_disableBlueprintErrors", "allow placement of some currently non-buildable structures", Cvar::USERINFO, 0, 0, 1);
@@ -757,6 +757,7 @@ static void CG_RegisterGraphics()
 
 	CG_UpdateLoadingStep( LOAD_GEOMETRY );
 	trap_R_LoadWorldMap( va( "maps/%s.bsp", cgs.mapname ) );
+	CG_InvalidateLightProbes();
 
 	CG_UpdateLoadingStep( LOAD_ASSETS );
 
@@ -1003,6 +1004,15 @@ static void CG_RegisterClients()
 			trap_UpdateScreen();
 		}
 	}
+	else
+	{
+		// load them in the background instead of when first seen, if
+		// cg_modelLoadBudget allows it
+		for ( i = PCL_NONE + 1; i < PCL_NUM_CLASSES; i++ )
+		{
+			CG_QueueClientModel( BG_ClassModelConfig( i )->modelName, BG_ClassModelConfig( i )->skinName );
+		}
+	}
 
 	// Borrow these variables for MD5 models so we don't have to create new ones.
 	cgs.media.larmourHeadSkin = trap_R_RegisterSkin( "models/players/human_base/body_helmet.skin" );
@@ -1400,6 +1410,8 @@ void CG_Init( int serverMessageNum, int clientNum, const glconfig_t& gl, const G
 	CG_ShaderStateChanged();
 
 	trap_Cvar_Set( "ui_winner", "" ); // Clear the previous round's winner.
+
+	CG_ClientModelStats();
 }
 
 /*
@@ -41,6 +41,106 @@ markPoly_t *cg_freeMarkPolys; // single linked list
 markPoly_t cg_markPolys[ MAX_MARK_POLYS ];
 static int markTotal;
 
+/*
+Every persistent CG_ImpactMark call is recorded as an impact, bucketed by
+the surface cell it hit. A new impact that is nearly identical to an
+existing one in its cell refreshes the existing polys instead of clipping
+and storing new ones, and a crowded cell gives up its own oldest impact
+before marks elsewhere are evicted.
+*/
+#define MAX_IMPACT_POLYS    8
+#define MARK_CELL_SIZE      64.0f
+#define MARK_CELL_BUCKETS   256 // must be a power of two
+#define MARK_CELL_CROWDED   4
+
+struct markImpact_t
+{
+	bool         inUse;
+	int          cell[ 4 ]; // x, y, z and dominant normal axis
+	unsigned     bucket;
+	vec3_t       origin;
+	vec3_t       normal;
+	float        radius;
+	qhandle_t    markShader;
+	int          time;
+
+	markPoly_t   *polys[ MAX_IMPACT_POLYS ];
+	int          numPolys;
+
+	markImpact_t *nextInBucket;
+};
+
+static markImpact_t markImpacts[ MAX_MARK_POLYS ];
+static markImpact_t *markCellBuckets[ MARK_CELL_BUCKETS ];
+
+/*
+Temporary marks such as shadows are usually projected with exactly the
+same parameters frame after frame, so the last few projections are kept.
+*/
+#define MAX_MARK_FRAGMENTS      128
+#define MAX_MARK_POINTS         384
+#define MARK_FRAGMENT_CACHE     16 // must be a power of two
+
+struct markFragmentCache_t
+{
+	bool           valid;
+	vec3_t         origin;
+	vec3_t         dir;
+	float          orientation;
+	float          radius;
+
+	int            numFragments;
+	markFragment_t fragments[ MAX_MARK_FRAGMENTS ];
+	int            numPoints;
+	vec3_t         points[ MAX_MARK_POINTS ];
+};
+
+static markFragmentCache_t markFragmentCache[ MARK_FRAGMENT_CACHE ];
+
+/*
+Shadows and wakes follow moving players, so their exact projections
+rarely repeat. Instead they are projected from a larger square around a
+grid cell, which covers the mark anywhere in that cell, and the fragments
+are clipped down to the real mark every frame.
+*/
+#define GROUND_MARK_CACHE       64 // must be a power of two
+
+static Cvar::Range<Cvar::Cvar<int>> cg_groundMarkCellSize(
+	"cg_groundMarkCellSize", "reuse shadow and wake projections within cells of this size (0 = off)",
+	Cvar::NONE, 16, 0, 64 );
+
+struct groundMarkCache_t
+{
+	bool           valid;
+	int            cell[ 3 ];
+	int            cellSize;
+	vec3_t         dir;
+	float          radius;
+
+	int            numFragments;
+	markFragment_t fragments[ MAX_MARK_FRAGMENTS ];
+	int            numPoints;
+	vec3_t         points[ MAX_MARK_POINTS ];
+};
+
+static groundMarkCache_t groundMarkCache[ GROUND_MARK_CACHE ];
+
+struct markStats_t
+{
+	int impacts;
+	int merged;
+	int evicted;
+	int crowdedEvictions;
+	int expired;
+	int projections;
+	int cachedProjections;
+	int groundProjections;
+	int cachedGroundProjections;
+	int batches;
+};
+
+static markStats_t markStats;
+
 /*
 ===================
 CG_InitMarkPolys
@@ -53,6 +153,11 @@ void CG_InitMarkPolys()
 	int i;
 
 	memset( cg_markPolys, 0, sizeof( cg_markPolys ) );
+	memset( markImpacts, 0, sizeof( markImpacts ) );
+	memset( markCellBuckets, 0, sizeof( markCellBuckets ) );
+	memset( markFragmentCache, 0, sizeof( markFragmentCache ) );
+	memset( groundMarkCache, 0, sizeof( groundMarkCache ) );
+	memset( &markStats, 0, sizeof( markStats ) );
 
 	cg_activeMarkPolys.nextMark = &cg_activeMarkPolys;
 	cg_activeMarkPolys.prevMark = &cg_activeMarkPolys;
@@ -64,6 +169,56 @@ void CG_InitMarkPolys()
 	}
 }
 
+/*
+==================
+CG_MarkCell
+
+Quantize an impact to the surface cell it belongs to
+==================
+*/
+static unsigned CG_MarkCell( const vec3_t origin, const vec3_t normal, int cell[ 4 ] )
+{
+	int axis = 0;
+
+	for ( int i = 0; i < 3; i++ )
+	{
+		cell[ i ] = ( int ) floorf( origin[ i ] / MARK_CELL_SIZE );
+
+		if ( fabsf( normal[ i ] ) > fabsf( normal[ axis ] ) )
+		{
+			axis = i;
+		}
+	}
+
+	cell[ 3 ] = normal[ axis ] < 0.0f ? axis + 3 : axis;
+
+	return ( ( unsigned ) cell[ 0 ] * 73856093u ^ ( unsigned ) cell[ 1 ] * 19349663u ^
+	         ( unsigned ) cell[ 2 ] * 83492791u ^ ( unsigned ) cell[ 3 ] ) & ( MARK_CELL_BUCKETS - 1 );
+}
+
+/*
+==================
+CG_FreeMarkImpact
+
+Unlink an impact from its cell once its last poly is gone
+==================
+*/
+static void CG_FreeMarkImpact( markImpact_t *impact )
+{
+	markImpact_t **link;
+
+	for ( link = &markCellBuckets[ impact->bucket ]; *link; link = &( *link )->nextInBucket )
+	{
+		if ( *link == impact )
+		{
+			*link = impact->nextInBucket;
+			break;
+		}
+	}
+
+	impact->inUse = false;
+}
+
 /*
 ==================
 CG_FreeMarkPoly
@@ -71,11 +226,32 @@ CG_FreeMarkPoly
 */
 static void CG_FreeMarkPoly( markPoly_t *le )
 {
+	markImpact_t *impact = le->impact;
+
 	if ( !le->prevMark )
 	{
 		Sys::Drop( "CG_FreeMarkPoly: not active" );
 	}
 
+	if ( impact )
+	{
+		for ( int i = 0; i < impact->numPolys; i++ )
+		{
+			if ( impact->polys[ i ] == le )
+			{
+				impact->polys[ i ] = impact->polys[ --impact->numPolys ];
+				break;
+			}
+		}
+
+		if ( !impact->numPolys )
+		{
+			CG_FreeMarkImpact( impact );
+		}
+
+		le->impact = nullptr;
+	}
+
 	// remove from the doubly linked active list
 	le->prevMark->nextMark = le->nextMark;
 	le->nextMark->prevMark = le->prevMark;
@@ -85,6 +261,62 @@ static void CG_FreeMarkPoly( markPoly_t *le )
 	cg_freeMarkPolys = le;
 }
 
+/*
+==================
+CG_LinkMarkPoly
+
+Put a mark poly at the front (newest end) of the active list
+==================
+*/
+static void CG_LinkMarkPoly( markPoly_t *le )
+{
+	le->nextMark = cg_activeMarkPolys.nextMark;
+	le->prevMark = &cg_activeMarkPolys;
+	cg_activeMarkPolys.nextMark->prevMark = le;
+	cg_activeMarkPolys.nextMark = le;
+}
+
+/*
+===================
+CG_EvictCrowdedCell
+
+Free the oldest impact in a cell that already holds several
+===================
+*/
+static void CG_EvictCrowdedCell( unsigned bucket, const int cell[ 4 ] )
+{
+	markImpact_t *oldest = nullptr;
+	int          count = 0;
+
+	for ( markImpact_t *impact = markCellBuckets[ bucket ]; impact; impact = impact->nextInBucket )
+	{
+		// impacts still being filled in have no polys to give back
+		if ( !impact->numPolys || memcmp( impact->cell, cell, sizeof( impact->cell ) ) )
+		{
+			continue;
+		}
+
+		count++;
+
+		if ( !oldest || impact->time < oldest->time )
+		{
+			oldest = impact;
+		}
+	}
+
+	if ( count < MARK_CELL_CROWDED )
+	{
+		return;
+	}
+
+	while ( oldest->inUse && oldest->numPolys )
+	{
+		CG_FreeMarkPoly( oldest->polys[ 0 ] );
+	}
+
+	markStats.crowdedEvictions++;
+}
+
 /*
 ===================
 CG_AllocMark
@@ -92,11 +324,17 @@ CG_AllocMark
 Will always succeed, even if it requires freeing an old active mark
 ===================
 */
-static markPoly_t *CG_AllocMark()
+static markPoly_t *CG_AllocMark( unsigned bucket, const int cell[ 4 ] )
 {
 	markPoly_t *le;
 	int        time;
 
+	if ( !cg_freeMarkPolys )
+	{
+		// make room in the spot being hit before anywhere else
+		CG_EvictCrowdedCell( bucket, cell );
+	}
+
 	if ( !cg_freeMarkPolys )
 	{
 		// no free entities, so free the one at the end of the chain
@@ -106,6 +344,7 @@ static markPoly_t *CG_AllocMark()
 		while ( cg_activeMarkPolys.prevMark && time == cg_activeMarkPolys.prevMark->time )
 		{
 			CG_FreeMarkPoly( cg_activeMarkPolys.prevMark );
+			markStats.evicted++;
 		}
 	}
 
@@ -115,13 +354,375 @@ static markPoly_t *CG_AllocMark()
 	memset( le, 0, sizeof( *le ) );
 
 	// link into the active list
-	le->nextMark = cg_activeMarkPolys.nextMark;
-	le->prevMark = &cg_activeMarkPolys;
-	cg_activeMarkPolys.nextMark->prevMark = le;
-	cg_activeMarkPolys.nextMark = le;
+	CG_LinkMarkPoly( le );
 	return le;
 }
 
+/*
+===================
+CG_AllocMarkImpact
+
+Find a free impact record and link it into its cell
+===================
+*/
+static markImpact_t *CG_AllocMarkImpact( unsigned bucket, const vec3_t origin, const vec3_t normal )
+{
+	for ( int i = 0; i < MAX_MARK_POLYS; i++ )
+	{
+		markImpact_t *impact = &markImpacts[ i ];
+
+		if ( impact->inUse )
+		{
+			continue;
+		}
+
+		memset( impact, 0, sizeof( *impact ) );
+		impact->inUse = true;
+		VectorCopy( origin, impact->origin );
+		VectorCopy( normal, impact->normal );
+		impact->bucket = CG_MarkCell( origin, normal, impact->cell );
+
+		impact->nextInBucket = markCellBuckets[ bucket ];
+		markCellBuckets[ bucket ] = impact;
+		return impact;
+	}
+
+	// can't happen, every impact owns at least one of the polys
+	return nullptr;
+}
+
+/*
+===================
+CG_MergeMark
+
+Refresh an existing mark that is nearly identical to a new impact,
+returns false if there isn't one
+===================
+*/
+static bool CG_MergeMark( unsigned bucket, const int cell[ 4 ], qhandle_t markShader,
+                          const vec3_t origin, const vec3_t normal, float radius,
+                          const float color[ 4 ], bool alphaFade )
+{
+	markImpact_t *impact;
+
+	for ( impact = markCellBuckets[ bucket ]; impact; impact = impact->nextInBucket )
+	{
+		if ( impact->markShader == markShader &&
+		     !memcmp( impact->cell, cell, sizeof( impact->cell ) ) &&
+		     fabsf( impact->radius - radius ) <= 0.25f * radius &&
+		     DotProduct( impact->normal, normal ) > 0.95f &&
+		     Distance( impact->origin, origin ) <= 0.25f * radius )
+		{
+			break;
+		}
+	}
+
+	if ( !impact )
+	{
+		return false;
+	}
+
+	impact->time = cg.time;
+
+	for ( int i = 0; i < impact->numPolys; i++ )
+	{
+		markPoly_t *mark = impact->polys[ i ];
+		byte       colors[ 4 ];
+
+		colors[ 0 ] = color[ 0 ] * 255;
+		colors[ 1 ] = color[ 1 ] * 255;
+		colors[ 2 ] = color[ 2 ] * 255;
+		colors[ 3 ] = color[ 3 ] * 255;
+
+		mark->time = cg.time;
+		mark->alphaFade = alphaFade;
+		Vector4Copy( color, mark->color );
+
+		for ( int j = 0; j < mark->poly.numVerts; j++ )
+		{
+			* ( int * ) mark->verts[ j ].modulate = * ( int * ) colors;
+		}
+
+		// keep the active list sorted by age
+		mark->prevMark->nextMark = mark->nextMark;
+		mark->nextMark->prevMark = mark->prevMark;
+		CG_LinkMarkPoly( mark );
+	}
+
+	markStats.merged++;
+	return true;
+}
+
+/*
+=================
+CG_MarkFragments
+
+trap_CM_MarkFragments, with the results of the last few projections kept
+=================
+*/
+static int CG_MarkFragments( const vec3_t origin, const vec3_t dir, float orientation, float radius,
+                             const vec3_t originalPoints[ 4 ], vec3_t *markPoints,
+                             markFragment_t *markFragments )
+{
+	markFragmentCache_t *entry;
+	vec3_t              projection;
+	const float         key[] = { origin[ 0 ], origin[ 1 ], origin[ 2 ], dir[ 0 ], dir[ 1 ], dir[ 2 ],
+	                              orientation, radius };
+	uint32_t            hash = BG_HashBytes( BG_HASH_INIT, key, sizeof( key ) );
+
+	entry = &markFragmentCache[ hash & ( MARK_FRAGMENT_CACHE - 1 ) ];
+
+	if ( entry->valid && VectorCompare( entry->origin, origin ) && VectorCompare( entry->dir, dir ) &&
+	     entry->orientation == orientation && entry->radius == radius )
+	{
+		memcpy( markFragments, entry->fragments, entry->numFragments * sizeof( markFragment_t ) );
+		memcpy( markPoints, entry->points, entry->numPoints * sizeof( vec3_t ) );
+		markStats.cachedProjections++;
+		return entry->numFragments;
+	}
+
+	VectorScale( dir, -20, projection );
+	entry->numFragments = trap_CM_MarkFragments( 4, originalPoints,
+	                                             projection, MAX_MARK_POINTS, entry->points[ 0 ],
+	                                             MAX_MARK_FRAGMENTS, entry->fragments );
+	markStats.projections++;
+
+	entry->numPoints = 0;
+
+	for ( int i = 0; i < entry->numFragments; i++ )
+	{
+		const markFragment_t &mf = entry->fragments[ i ];
+
+		entry->numPoints = std::max( entry->numPoints, mf.firstPoint + mf.numPoints );
+	}
+
+	entry->valid = true;
+	VectorCopy( origin, entry->origin );
+	VectorCopy( dir, entry->dir );
+	entry->orientation = orientation;
+	entry->radius = radius;
+
+	memcpy( markFragments, entry->fragments, entry->numFragments * sizeof( markFragment_t ) );
+	memcpy( markPoints, entry->points, entry->numPoints * sizeof( vec3_t ) );
+	return entry->numFragments;
+}
+
+/*
+=================
+CG_GroundMarkFragments
+
+Fragments covering a mark of the given radius anywhere within the grid
+cell of origin, on the plane through origin
+=================
+*/
+static int CG_GroundMarkFragments( const vec3_t origin, const vec3_t dir, float radius, int cellSize,
+                                   vec3_t *markPoints, markFragment_t *markFragments )
+{
+	groundMarkCache_t *entry;
+	int               cell[ 3 ];
+	unsigned          hash;
+	vec3_t            center, delta, axis[ 2 ], points[ 4 ], projection;
+	float             size;
+
+	for ( int i = 0; i < 3; i++ )
+	{
+		cell[ i ] = ( int ) floorf( origin[ i ] / cellSize );
+	}
+
+	hash = ( unsigned ) cell[ 0 ] * 73856093u ^ ( unsigned ) cell[ 1 ] * 19349663u ^
+	       ( unsigned ) cell[ 2 ] * 83492791u ^ ( unsigned )( radius * 16.0f );
+	entry = &groundMarkCache[ hash & ( GROUND_MARK_CACHE - 1 ) ];
+
+	if ( entry->valid && !memcmp( entry->cell, cell, sizeof( cell ) ) && entry->cellSize == cellSize &&
+	     VectorCompare( entry->dir, dir ) && entry->radius == radius )
+	{
+		memcpy( markFragments, entry->fragments, entry->numFragments * sizeof( markFragment_t ) );
+		memcpy( markPoints, entry->points, entry->numPoints * sizeof( vec3_t ) );
+		markStats.cachedGroundProjections++;
+		return entry->numFragments;
+	}
+
+	// the cell centre moved onto the plane is within half a cell
+	// diagonal of origin, and the mark may be turned any way
+	for ( int i = 0; i < 3; i++ )
+	{
+		center[ i ] = ( cell[ i ] + 0.5f ) * cellSize;
+	}
+
+	VectorSubtract( center, origin, delta );
+	VectorMA( center, -DotProduct( delta, dir ), dir, center );
+	size = radius * M_SQRT2 + cellSize * 0.87f;
+
+	PerpendicularVector( axis[ 0 ], dir );
+	CrossProduct( dir, axis[ 0 ], axis[ 1 ] );
+
+	for ( int i = 0; i < 3; i++ )
+	{
+		points[ 0 ][ i ] = center[ i ] - size * axis[ 0 ][ i ] - size * axis[ 1 ][ i ];
+		points[ 1 ][ i ] = center[ i ] + size * axis[ 0 ][ i ] - size * axis[ 1 ][ i ];
+		points[ 2 ][ i ] = center[ i ] + size * axis[ 0 ][ i ] + size * axis[ 1 ][ i ];
+		points[ 3 ][ i ] = center[ i ] - size * axis[ 0 ][ i ] + size * axis[ 1 ][ i ];
+	}
+
+	VectorScale( dir, -20, projection );
+	entry->numFragments = trap_CM_MarkFragments( 4, points,
+	                                             projection, MAX_MARK_POINTS, entry->points[ 0 ],
+	                                             MAX_MARK_FRAGMENTS, entry->fragments );
+	markStats.groundProjections++;
+
+	entry->numPoints = 0;
+
+	for ( int i = 0; i < entry->numFragments; i++ )
+	{
+		const markFragment_t &mf = entry->fragments[ i ];
+
+		entry->numPoints = std::max( entry->numPoints, mf.firstPoint + mf.numPoints );
+	}
+
+	entry->valid = true;
+	memcpy( entry->cell, cell, sizeof( cell ) );
+	entry->cellSize = cellSize;
+	VectorCopy( dir, entry->dir );
+	entry->radius = radius;
+
+	memcpy( markFragments, entry->fragments, entry->numFragments * sizeof( markFragment_t ) );
+	memcpy( markPoints, entry->points, entry->numPoints * sizeof( vec3_t ) );
+	return entry->numFragments;
+}
+
+/*
+=================
+CG_ClipMarkPoly
+
+Clips a polygon to the part with texture coordinates within 0 and 1
+=================
+*/
+static int CG_ClipMarkPoly( polyVert_t *verts, int numVerts, int maxVerts )
+{
+	polyVert_t clipped[ MAX_VERTS_ON_POLY + 4 ];
+
+	for ( int side = 0; side < 4; side++ )
+	{
+		int   axis = side >> 1;
+		float sign = ( side & 1 ) ? -1.0f : 1.0f;
+		float bias = ( side & 1 ) ? 1.0f : 0.0f;
+		int   numClipped = 0;
+
+		for ( int i = 0; i < numVerts; i++ )
+		{
+			const polyVert_t &a = verts[ i ];
+			const polyVert_t &b = verts[ ( i + 1 ) % numVerts ];
+			float            da = sign * a.st[ axis ] + bias;
+			float            db = sign * b.st[ axis ] + bias;
+
+			if ( da >= 0.0f && numClipped < ( int ) ARRAY_LEN( clipped ) )
+			{
+				clipped[ numClipped++ ] = a;
+			}
+
+			if ( ( da >= 0.0f ) != ( db >= 0.0f ) && numClipped < ( int ) ARRAY_LEN( clipped ) )
+			{
+				polyVert_t &v = clipped[ numClipped++ ];
+				float      frac = da / ( da - db );
+
+				v = a;
+				VectorLerpTrem( frac, a.xyz, b.xyz, v.xyz );
+				v.st[ 0 ] = a.st[ 0 ] + frac * ( b.st[ 0 ] - a.st[ 0 ] );
+				v.st[ 1 ] = a.st[ 1 ] + frac * ( b.st[ 1 ] - a.st[ 1 ] );
+			}
+		}
+
+		numVerts = std::min( numClipped, maxVerts );
+		memcpy( verts, clipped, numVerts * sizeof( polyVert_t ) );
+
+		if ( numVerts < 3 )
+		{
+			return 0;
+		}
+	}
+
+	return numVerts;
+}
+
+/*
+=================
+CG_GroundMark
+
+A temporary mark for something moving along the ground, such as a shadow
+=================
+*/
+void CG_GroundMark( qhandle_t markShader, const vec3_t origin, const vec3_t dir,
+                    float orientation, float red, float green, float blue, float alpha,
+                    float radius )
+{
+	vec3_t         axis[ 3 ];
+	float          texCoordScale;
+	byte           colors[ 4 ];
+	int            numFragments;
+	markFragment_t markFragments[ MAX_MARK_FRAGMENTS ], *mf;
+	vec3_t         markPoints[ MAX_MARK_POINTS ];
+	int            cellSize = cg_groundMarkCellSize.Get();
+
+	if ( !cellSize )
+	{
+		CG_ImpactMark( markShader, origin, dir, orientation, red, green, blue, alpha, false, radius, true );
+		return;
+	}
+
+	if ( !cg_addMarks.Get() || CG_CullPointAndRadius( origin, M_SQRT2 * radius ) )
+	{
+		return;
+	}
+
+	if ( radius <= 0 )
+	{
+		Sys::Drop( "CG_GroundMark called with <= 0 radius" );
+	}
+
+	VectorNormalize2( dir, axis[ 0 ] );
+	PerpendicularVector( axis[ 1 ], axis[ 0 ] );
+	RotatePointAroundVector( axis[ 2 ], axis[ 0 ], axis[ 1 ], orientation );
+	CrossProduct( axis[ 0 ], axis[ 2 ], axis[ 1 ] );
+
+	texCoordScale = 0.5 * 1.0 / radius;
+
+	numFragments = CG_GroundMarkFragments( origin, axis[ 0 ], radius, cellSize, markPoints, markFragments );
+
+	colors[ 0 ] = red * 255;
+	colors[ 1 ] = green * 255;
+	colors[ 2 ] = blue * 255;
+	colors[ 3 ] = alpha * 255;
+
+	for ( int i = 0; i < numFragments; i++ )
+	{
+		polyVert_t verts[ MAX_VERTS_ON_POLY + 4 ];
+		int        numVerts;
+
+		mf = &markFragments[ i ];
+		numVerts = std::min( mf->numPoints, MAX_VERTS_ON_POLY );
+
+		for ( int j = 0; j < numVerts; j++ )
+		{
+			polyVert_t *v = &verts[ j ];
+			vec3_t     delta;
+
+			VectorCopy( markPoints[ mf->firstPoint + j ], v->xyz );
+
+			VectorSubtract( v->xyz, origin, delta );
+			v->st[ 0 ] = 0.5 + DotProduct( delta, axis[ 1 ] ) * texCoordScale;
+			v->st[ 1 ] = 0.5 + DotProduct( delta, axis[ 2 ] ) * texCoordScale;
+			* ( int * ) v->modulate = * ( int * ) colors;
+		}
+
+		numVerts = CG_ClipMarkPoly( verts, numVerts, MAX_VERTS_ON_POLY );
+
+		if ( numVerts )
+		{
+			trap_R_AddPolyToScene( markShader, numVerts, verts );
+		}
+	}
+}
+
 /*
 =================
 CG_ImpactMark
@@ -133,9 +734,6 @@ temporary marks will not be stored or randomly oriented, but immediately
 passed to the renderer.
 =================
 */
-#define MAX_MARK_FRAGMENTS 128
-#define MAX_MARK_POINTS    384
-
 void CG_ImpactMark( qhandle_t markShader, const vec3_t origin, const vec3_t dir,
                     float orientation, float red, float green, float blue, float alpha,
                     bool alphaFade, float radius, bool temporary )
@@ -148,7 +746,10 @@ void CG_ImpactMark( qhandle_t markShader, const vec3_t origin, const vec3_t dir,
 	int            numFragments;
 	markFragment_t markFragments[ MAX_MARK_FRAGMENTS ], *mf;
 	vec3_t         markPoints[ MAX_MARK_POINTS ];
-	vec3_t         projection;
+	const float    color[ 4 ] = { red, green, blue, alpha };
+	markImpact_t   *impact = nullptr;
+	int            cell[ 4 ] = { 0, 0, 0, 0 };
+	unsigned       bucket = 0;
 
 	if ( !cg_addMarks.Get() )
 	{
@@ -174,6 +775,18 @@ void CG_ImpactMark( qhandle_t markShader, const vec3_t origin, const vec3_t dir,
 
 	// create the texture axis
 	VectorNormalize2( dir, axis[ 0 ] );
+
+	if ( !temporary )
+	{
+		bucket = CG_MarkCell( origin, axis[ 0 ], cell );
+
+		// another hit on the same spot only refreshes the mark already there
+		if ( CG_MergeMark( bucket, cell, markShader, origin, axis[ 0 ], radius, color, alphaFade ) )
+		{
+			return;
+		}
+	}
+
 	PerpendicularVector( axis[ 1 ], axis[ 0 ] );
 	RotatePointAroundVector( axis[ 2 ], axis[ 0 ], axis[ 1 ], orientation );
 	CrossProduct( axis[ 0 ], axis[ 2 ], axis[ 1 ] );
@@ -190,16 +803,28 @@ void CG_ImpactMark( qhandle_t markShader, const vec3_t origin, const vec3_t dir,
 	}
 
 	// get the fragments
-	VectorScale( dir, -20, projection );
-	numFragments = trap_CM_MarkFragments( 4, ( const vec3_t * ) originalPoints,
-	                                      projection, MAX_MARK_POINTS, markPoints[ 0 ],
-	                                      MAX_MARK_FRAGMENTS, markFragments );
+	numFragments = CG_MarkFragments( origin, dir, orientation, radius,
+	                                 ( const vec3_t * ) originalPoints, markPoints, markFragments );
 
 	colors[ 0 ] = red * 255;
 	colors[ 1 ] = green * 255;
 	colors[ 2 ] = blue * 255;
 	colors[ 3 ] = alpha * 255;
 
+	if ( !temporary && numFragments > 0 )
+	{
+		impact = CG_AllocMarkImpact( bucket, origin, axis[ 0 ] );
+
+		if ( impact )
+		{
+			impact->radius = radius;
+			impact->markShader = markShader;
+			impact->time = cg.time;
+		}
+
+		markStats.impacts++;
+	}
+
 	for ( i = 0, mf = markFragments; i < numFragments; i++, mf++ )
 	{
 		polyVert_t *v;
@@ -233,7 +858,7 @@ void CG_ImpactMark( qhandle_t markShader, const vec3_t origin, const vec3_t dir,
 		}
 
 		// otherwise save it persistently
-		mark = CG_AllocMark();
+		mark = CG_AllocMark( bucket, cell );
 		mark->time = cg.time;
 		mark->alphaFade = alphaFade;
 		mark->markShader = markShader;
@@ -244,6 +869,19 @@ void CG_ImpactMark( qhandle_t markShader, const vec3_t origin, const vec3_t dir,
 		mark->color[ 3 ] = alpha;
 		memcpy( mark->verts, verts, mf->numPoints * sizeof( verts[ 0 ] ) );
 		markTotal++;
+
+		// the impact may have been evicted to make room for its own polys
+		if ( impact && impact->inUse && impact->numPolys < MAX_IMPACT_POLYS )
+		{
+			mark->impact = impact;
+			impact->polys[ impact->numPolys++ ] = mark;
+		}
+	}
+
+	// nothing was attached to it
+	if ( impact && impact->inUse && !impact->numPolys )
+	{
+		CG_FreeMarkImpact( impact );
 	}
 }
 
@@ -257,10 +895,13 @@ CG_AddMarks
 
 void CG_AddMarks()
 {
-	int        j;
-	markPoly_t *mp, *next;
-	int        t;
-	int        fade;
+	int               j;
+	markPoly_t        *mp, *next;
+	int               t;
+	int               fade;
+	static markPoly_t *visible[ MAX_MARK_POLYS ];
+	static polyVert_t batch[ MAX_MARK_POLYS * MAX_VERTS_ON_POLY ];
+	int               numVisible = 0;
 
 	if ( !cg_addMarks.Get() )
 	{
@@ -279,6 +920,7 @@ void CG_AddMarks()
 		if ( cg.time > mp->time + MARK_TOTAL_TIME )
 		{
 			CG_FreeMarkPoly( mp );
+			markStats.expired++;
 			continue;
 		}
 
@@ -306,6 +948,65 @@ void CG_AddMarks()
 				}
 			}
 		}
-		trap_R_AddPolyToScene( mp->markShader, mp->poly.numVerts, mp->verts );
+
+		visible[ numVisible++ ] = mp;
 	}
+
+	// one trap_R_AddPolysToScene per shader and poly size, keeping overlapping
+	// marks in the order they were made so they don't flicker
+	std::stable_sort( visible, visible + numVisible, []( const markPoly_t *a, const markPoly_t *b ) {
+		return a->markShader != b->markShader ? a->markShader < b->markShader
+		                                      : a->poly.numVerts < b->poly.numVerts;
+	} );
+
+	for ( int start = 0, end; start < numVisible; start = end )
+	{
+		qhandle_t shader = visible[ start ]->markShader;
+		int       numVerts = visible[ start ]->poly.numVerts;
+
+		for ( end = start; end < numVisible && visible[ end ]->markShader == shader &&
+		      visible[ end ]->poly.numVerts == numVerts; end++ )
+		{
+			memcpy( &batch[ ( end - start ) * numVerts ], visible[ end ]->verts,
+			        numVerts * sizeof( polyVert_t ) );
+		}
+
+		trap_R_AddPolysToScene( shader, numVerts, batch, end - start );
+		markStats.batches++;
+	}
+}
+
+/*
+===============
+CG_MarkStats_f
+
+Print how the mark polys are being used
+===============
+*/
+void CG_MarkStats_f()
+{
+	int active = 0, impacts = 0;
+
+	for ( markPoly_t *mp = cg_activeMarkPolys.nextMark; mp && mp != &cg_activeMarkPolys; mp = mp->nextMark )
+	{
+		active++;
+	}
+
+	for ( int i = 0; i < MAX_MARK_POLYS; i++ )
+	{
+		if ( markImpacts[ i ].inUse )
+		{
+			impacts++;
+		}
+	}
+
+	Log::Notice( "%d/%d mark polys active from %d impacts", active, MAX_MARK_POLYS, impacts );
+	Log::Notice( "%d impacts stored, %d merged into an existing mark", markStats.impacts, markStats.merged );
+	Log::Notice( "%d polys expired, %d evicted oldest first, %d crowded impacts evicted",
+	             markStats.expired, markStats.evicted, markStats.crowdedEvictions );
+	Log::Notice( "%d projections, %d served from the cache", markStats.projections,
+	             markStats.cachedProjections );
+	Log::Notice( "%d ground projections, %d served from the cache", markStats.groundProjections,
+	             markStats.cachedGroundProjections );
+	Log::Notice( "%d batches submitted", markStats.batches );
 }
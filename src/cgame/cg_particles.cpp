@@ -41,6 +41,35 @@ static particle_t            particles[ MAX_PARTICLES ];
 static particle_t            *sortedParticles[ MAX_PARTICLES ];
 static particle_t            *radixBuffer[ MAX_PARTICLES ];
 
+// set while CG_ParticleBenchmark_f replays frames, suppresses side effects
+static bool                  particleBenchmarkRunning = false;
+static bool                  particleGroupCollisionDisabled = false;
+
+static Cvar::Cvar<bool> cg_particleLOD(
+	"cg_particleLOD", "throttle, freeze and evict the least important particle systems when over budget",
+	Cvar::NONE, true );
+static Cvar::Range<Cvar::Cvar<int>> cg_particleBudget(
+	"cg_particleBudget", "number of live particles the level of detail scheduler aims for",
+	Cvar::NONE, MAX_PARTICLES / 2, 1, MAX_PARTICLES );
+
+// rough extent of a particle system, used for culling and importance
+#define PARTICLE_SYSTEM_RADIUS 256.0f
+
+struct particleSchedule_t
+{
+	float load; // live particles over the budget
+	int   numCulled;
+	int   numThrottled;
+	int   numEvicted; // since the cgame started
+};
+
+static particleSchedule_t particleSchedule;
+
+// the system whose ejectors are running, which mustn't be evicted by its own children
+static particleSystem_t   *particleSystemEjecting = nullptr;
+
+static particleSystem_t   *testPS;
+
 /*
 ===============
 CG_LerpValues
@@ -110,7 +139,7 @@ Destroy an individual particle
 static void CG_DestroyParticle( particle_t *p, vec3_t impactNormal )
 {
 	//this particle has an onDeath particle system attached
-	if ( p->class_->onDeathSystemName[ 0 ] != '\0' )
+	if ( p->class_->onDeathSystemName[ 0 ] != '\0' && !particleBenchmarkRunning )
 	{
 		particleSystem_t *ps;
 
@@ -365,11 +394,11 @@ static particle_t *CG_SpawnNewParticle( baseParticle_t *bp, particleEjector_t *p
 				}
 			}
 
-			break;
+			return p;
 		}
 	}
 
-	return p;
+	return nullptr;
 }
 
 /*
@@ -411,9 +440,20 @@ static void CG_SpawnNewParticles()
 				while ( pe->nextEjectionTime <= cg.time &&
 				        ( pe->count > 0 || pe->totalParticles == PARTICLES_INFINITE ) )
 				{
-					for ( j = 0; j < bpe->numParticles; j++ )
+					//throttled systems skip some of their ejections
+					ps->ejectionCredit += ps->ejectionScale;
+
+					if ( ps->ejectionCredit >= 1.0f )
 					{
-						CG_SpawnNewParticle( bpe->particles[ j ], pe );
+						ps->ejectionCredit -= 1.0f;
+						particleSystemEjecting = ps;
+
+						for ( j = 0; j < bpe->numParticles; j++ )
+						{
+							CG_SpawnNewParticle( bpe->particles[ j ], pe );
+						}
+
+						particleSystemEjecting = nullptr;
 					}
 
 					if ( pe->count > 0 )
@@ -504,6 +544,123 @@ static particleEjector_t *CG_SpawnNewParticleEjector( baseParticleEjector_t *bpe
 	return pe;
 }
 
+/*
+===============
+CG_ForgetParticleSystem
+
+Clear every reference to a particle system that is going away without its
+owner asking, so that the owner doesn't go on to use whatever takes its slot
+===============
+*/
+static void CG_ForgetParticleSystemRef( particleSystem_t **ref, const particleSystem_t *ps )
+{
+	if ( *ref == ps )
+	{
+		*ref = nullptr;
+	}
+}
+
+static void CG_ForgetParticleSystemCent( centity_t *cent, const particleSystem_t *ps )
+{
+	CG_ForgetParticleSystemRef( &cent->muzzlePS, ps );
+	CG_ForgetParticleSystemRef( &cent->jetPackPS[ 0 ], ps );
+	CG_ForgetParticleSystemRef( &cent->jetPackPS[ 1 ], ps );
+	CG_ForgetParticleSystemRef( &cent->buildablePS, ps );
+	CG_ForgetParticleSystemRef( &cent->buildableStatusPS, ps );
+	CG_ForgetParticleSystemRef( &cent->entityPS, ps );
+	CG_ForgetParticleSystemRef( &cent->missilePS, ps );
+}
+
+static void CG_ForgetParticleSystem( const particleSystem_t *ps )
+{
+	int i;
+
+	for ( i = 0; i < MAX_GENTITIES; i++ )
+	{
+		CG_ForgetParticleSystemCent( &cg_entities[ i ], ps );
+	}
+
+	CG_ForgetParticleSystemCent( &cg.predictedPlayerEntity, ps );
+
+	for ( i = 0; i < MAX_PARTICLES; i++ )
+	{
+		CG_ForgetParticleSystemRef( &particles[ i ].childParticleSystem, ps );
+	}
+
+	CG_ForgetParticleSystemRef( &testPS, ps );
+}
+
+/*
+===============
+CG_EvictParticleSystem
+
+Free up the slot of the least important finite particle system, if it
+matters less than the new system that wants to take its place
+===============
+*/
+static particleSystem_t *CG_EvictParticleSystem( float importance )
+{
+	particleSystem_t *victim = nullptr;
+	int              i;
+
+	if ( !cg_particleLOD.Get() )
+	{
+		return nullptr;
+	}
+
+	for ( i = 0; i < MAX_PARTICLE_SYSTEMS; i++ )
+	{
+		particleSystem_t *ps = &particleSystems[ i ];
+
+		//infinite systems belong to something that will keep using them
+		if ( ps == particleSystemEjecting ||
+		     ( !ps->lazyRemove && CG_IsParticleSystemInfinite( ps ) ) )
+		{
+			continue;
+		}
+
+		if ( !victim || ps->importance < victim->importance )
+		{
+			victim = ps;
+		}
+	}
+
+	if ( !victim || victim->importance >= importance )
+	{
+		return nullptr;
+	}
+
+	for ( i = 0; i < MAX_PARTICLES; i++ )
+	{
+		particle_t *p = &particles[ i ];
+
+		if ( p->valid && p->parent->parent == victim )
+		{
+			p->valid = false;
+			p->frameWhenInvalidated = cg.clientFrame;
+		}
+	}
+
+	for ( i = 0; i < MAX_PARTICLE_EJECTORS; i++ )
+	{
+		if ( particleEjectors[ i ].parent == victim )
+		{
+			particleEjectors[ i ].valid = false;
+		}
+	}
+
+	if ( cg_debugParticles.Get() >= 1 )
+	{
+		Log::Debug( "PS %s evicted", victim->class_->name );
+	}
+
+	victim->valid = false;
+	CG_ForgetParticleSystem( victim );
+	particleSchedule.numEvicted++;
+
+	return victim;
+}
+
 /*
 ===============
 CG_SpawnNewParticleSystem
@@ -525,34 +682,49 @@ particleSystem_t *CG_SpawnNewParticleSystem( qhandle_t psHandle )
 
 	for ( i = 0; i < MAX_PARTICLE_SYSTEMS; i++ )
 	{
-		ps = &particleSystems[ i ];
+		if ( !particleSystems[ i ].valid )
+		{
+			ps = &particleSystems[ i ];
+			break;
+		}
+	}
 
-		if ( !ps->valid )
+	//all slots taken, make room if something matters less than a new
+	//system, which counts as fully important until it has been scheduled
+	if ( !ps && !( ps = CG_EvictParticleSystem( 1.0f ) ) )
+	{
+		if ( cg_debugParticles.Get() >= 1 )
 		{
-			ps->~particleSystem_t();
-			new(ps) particleSystem_t{};
+			Log::Debug( "PS %s dropped, no free slots", bps->name );
+		}
 
-			//found a free slot
-			ps->class_ = bps;
+		return nullptr;
+	}
 
-			ps->valid = true;
-			ps->lazyRemove = false;
+	ps->~particleSystem_t();
+	new(ps) particleSystem_t{};
 
-			// use "up" as an arbitrary (non-null) "last" normal
-			VectorSet( ps->lastNormal, 0, 0, 1 );
+	//found a free slot
+	ps->class_ = bps;
 
-			for ( j = 0; j < bps->numEjectors; j++ )
-			{
-				CG_SpawnNewParticleEjector( bps->ejectors[ j ], ps );
-			}
+	ps->valid = true;
+	ps->lazyRemove = false;
 
-			if ( cg_debugParticles.Get() >= 1 )
-			{
-				Log::Debug( "PS %s created", bps->name );
-			}
+	// use "up" as an arbitrary (non-null) "last" normal
+	VectorSet( ps->lastNormal, 0, 0, 1 );
 
-			break;
-		}
+	// until the scheduler has had a look at it
+	ps->importance = 1.0f;
+	ps->ejectionScale = 1.0f;
+
+	for ( j = 0; j < bps->numEjectors; j++ )
+	{
+		CG_SpawnNewParticleEjector( bps->ejectors[ j ], ps );
+	}
+
+	if ( cg_debugParticles.Get() >= 1 )
+	{
+		Log::Debug( "PS %s created", bps->name );
 	}
 
 	return ps;
@@ -2139,6 +2311,97 @@ static void CG_GarbageCollectParticleSystems()
 	}
 }
 
+/*
+===============
+CG_ScheduleParticleSystems
+
+Score every particle system by how much it matters to the player and
+decide how much of its ejection it is allowed this frame. Systems that
+cover a good part of the screen or belong to the local player keep
+ejecting at full rate the longest; off-screen ones also stop simulating.
+===============
+*/
+static void CG_ScheduleParticleSystems()
+{
+	float need, fovScale;
+	int   i, numLive = 0;
+
+	particleSchedule.numCulled = 0;
+	particleSchedule.numThrottled = 0;
+
+	for ( i = 0; i < MAX_PARTICLES; i++ )
+	{
+		if ( particles[ i ].valid )
+		{
+			numLive++;
+		}
+	}
+
+	particleSchedule.load = ( float ) numLive / cg_particleBudget.Get();
+
+	//nothing is throttled below half the budget, at the full budget only
+	//systems twice as important as a nearby on-screen one eject at full rate
+	need = ( particleSchedule.load - 0.5f ) * 4.0f;
+	fovScale = tanf( DEG2RAD( cg.refdef.fov_x * 0.5f ) );
+
+	for ( i = 0; i < MAX_PARTICLE_SYSTEMS; i++ )
+	{
+		particleSystem_t *ps = &particleSystems[ i ];
+		vec3_t           point;
+		float            distance;
+
+		if ( !ps->valid )
+		{
+			continue;
+		}
+
+		if ( !cg_particleLOD.Get() )
+		{
+			ps->importance = 1.0f;
+			ps->culled = false;
+			ps->ejectionScale = 1.0f;
+			continue;
+		}
+
+		if ( !CG_AttachmentPoint( &ps->attachment, point ) )
+		{
+			ps->importance = 0.0f;
+			ps->culled = false;
+			ps->ejectionScale = 1.0f;
+			continue;
+		}
+
+		distance = std::max( Distance( point, cg.refdef.vieworg ), 1.0f );
+
+		//roughly the fraction of the screen the system covers,
+		//1 for one in view PARTICLE_SYSTEM_RADIUS away with a 90 degree fov
+		ps->importance = PARTICLE_SYSTEM_RADIUS / ( distance * fovScale );
+		ps->culled = CG_CullPointAndRadius( point, PARTICLE_SYSTEM_RADIUS );
+
+		if ( ps->culled )
+		{
+			ps->importance *= 0.25f;
+			particleSchedule.numCulled++;
+		}
+
+		//the player's own effects give feedback on what they are doing
+		if ( CG_AttachmentCentNum( &ps->attachment ) == cg.snap->ps.clientNum )
+		{
+			ps->importance *= 4.0f;
+		}
+
+		if ( need <= 0.0f || ps->importance >= need )
+		{
+			ps->ejectionScale = 1.0f;
+		}
+		else
+		{
+			ps->ejectionScale = ps->importance / need;
+			particleSchedule.numThrottled++;
+		}
+	}
+}
+
 /*
 ===============
 CG_CalculateTimeFrac
@@ -2157,27 +2420,18 @@ static float CG_CalculateTimeFrac( int birth, int life, int delay )
 
 /*
 ===============
-CG_EvaluateParticlePhysics
+CG_ParticleAcceleration
 
-Compute the physics on a specific particle
+Compute the acceleration acting on a specific particle, returns false if
+the particle shouldn't be moved this frame
 ===============
 */
-static void CG_EvaluateParticlePhysics( particle_t *p )
+static bool CG_ParticleAcceleration( particle_t *p, vec3_t acceleration )
 {
 	particleSystem_t *ps = p->parent->parent;
 	baseParticle_t   *bp = p->class_;
-	vec3_t           acceleration, newOrigin;
-	vec3_t           mins, maxs;
-	float            deltaTime, bounce, radius, dot;
-	trace_t          trace;
 	vec3_t           transform[ 3 ];
 
-	if ( p->atRest )
-	{
-		VectorClear( p->velocity );
-		return;
-	}
-
 	switch ( bp->accMoveType )
 	{
 		case PMT_STATIC:
@@ -2195,7 +2449,7 @@ static void CG_EvaluateParticlePhysics( particle_t *p )
 		case PMT_STATIC_TRANSFORM:
 			if ( !CG_AttachmentAxis( &ps->attachment, transform ) )
 			{
-				return;
+				return false;
 			}
 
 			if ( bp->accMoveValues.dirType == PMD_POINT )
@@ -2220,7 +2474,7 @@ static void CG_EvaluateParticlePhysics( particle_t *p )
 
 				if ( !CG_AttachmentPoint( &ps->attachment, point ) )
 				{
-					return;
+					return false;
 				}
 
 				VectorSubtract( point, p->origin, acceleration );
@@ -2229,7 +2483,7 @@ static void CG_EvaluateParticlePhysics( particle_t *p )
 			{
 				if ( !CG_AttachmentDir( &ps->attachment, acceleration ) )
 				{
-					return;
+					return false;
 				}
 			}
 
@@ -2238,7 +2492,7 @@ static void CG_EvaluateParticlePhysics( particle_t *p )
 		case PMT_NORMAL:
 			if ( !ps->normalValid )
 			{
-				return;
+				return false;
 			}
 
 			VectorCopy( ps->normal, acceleration );
@@ -2285,54 +2539,69 @@ static void CG_EvaluateParticlePhysics( particle_t *p )
 		             acceleration );
 	}
 
+	return true;
+}
+
+/*
+===============
+CG_ParticlePhysicsRadius
+
+The collision radius of a particle
+===============
+*/
+static float CG_ParticlePhysicsRadius( const particle_t *p )
+{
 	// Some particles have a visual radius that differs from their collision radius
-	if ( bp->physicsRadius )
+	if ( p->class_->physicsRadius )
 	{
-		radius = bp->physicsRadius;
-	}
-	else
-	{
-		radius = CG_LerpValues( p->radius.initial, p->radius.final,
-		                        CG_CalculateTimeFrac( p->birthTime, p->lifeTime,
-		                            p->radius.delay ) );
+		return p->class_->physicsRadius;
 	}
 
-	VectorSet( mins, -radius, -radius, -radius );
-	VectorSet( maxs, radius, radius, radius );
+	return CG_LerpValues( p->radius.initial, p->radius.final,
+	                      CG_CalculateTimeFrac( p->birthTime, p->lifeTime,
+	                          p->radius.delay ) );
+}
 
-	bounce = CG_RandomiseValue( bp->bounceFrac, bp->bounceFracRandFrac );
+/*
+===============
+CG_MoveParticleFreely
 
-	deltaTime = ( float )( cg.time - p->lastEvalTime ) * 0.001;
-	VectorMA( p->velocity, deltaTime, acceleration, p->velocity );
-	VectorMA( p->origin, deltaTime, p->velocity, newOrigin );
-	p->lastEvalTime = cg.time;
+Move a particle that is known not to hit anything
+===============
+*/
+static void CG_MoveParticleFreely( particle_t *p, const vec3_t newOrigin )
+{
+	VectorCopy( newOrigin, p->origin );
 
-	// we're not doing particle physics, but at least cull them in solids
-	if ( !cg_bounceParticles.Get() )
-	{
-		int contents = CM_PointContents( newOrigin, 0 );
+	if ( CG_IsParticleSystemValid( &p->childParticleSystem ) )
+		CG_SetParticleSystemLastNormal( p->childParticleSystem, nullptr );
+}
 
-		if ( ( contents & CONTENTS_SOLID ) || ( contents & CONTENTS_NODROP ) )
-		{
-			CG_DestroyParticle( p, nullptr );
-		}
-		else
-		{
-			VectorCopy( newOrigin, p->origin );
-		}
+/*
+===============
+CG_SweepParticle
 
-		return;
-	}
+Trace a particle to its new origin and bounce it off whatever it hits
+===============
+*/
+static void CG_SweepParticle( particle_t *p, const vec3_t newOrigin, float radius, float bounce )
+{
+	particleSystem_t *ps = p->parent->parent;
+	baseParticle_t   *bp = p->class_;
+	vec3_t           mins, maxs;
+	float            dot;
+	trace_t          trace;
+
+	VectorSet( mins, -radius, -radius, -radius );
+	VectorSet( maxs, radius, radius, radius );
 
 	CG_Trace( &trace, p->origin, mins, maxs, newOrigin, CG_AttachmentCentNum( &ps->attachment ),
 	          CONTENTS_SOLID, 0 );
 
-	//not hit anything or not a collider
-	if ( trace.fraction == 1.0f || bounce == 0.0f )
+	//not hit anything
+	if ( trace.fraction == 1.0f )
 	{
-		VectorCopy( newOrigin, p->origin );
-		if ( CG_IsParticleSystemValid( &p->childParticleSystem ) )
-			CG_SetParticleSystemLastNormal( p->childParticleSystem, nullptr );
+		CG_MoveParticleFreely( p, newOrigin );
 		return;
 	}
 
@@ -2362,14 +2631,14 @@ static void CG_EvaluateParticlePhysics( particle_t *p )
 		p->atRest = true;
 	}
 
-	if ( bp->bounceMarkName[ 0 ] && p->bounceMarkCount > 0 )
+	if ( bp->bounceMarkName[ 0 ] && p->bounceMarkCount > 0 && !particleBenchmarkRunning )
 	{
 		CG_ImpactMark( bp->bounceMark, trace.endpos, trace.plane.normal,
 		               random() * 360, 1, 1, 1, 1, true, bp->bounceMarkRadius, false );
 		p->bounceMarkCount--;
 	}
 
-	if ( bp->bounceSoundName[ 0 ] && p->bounceSoundCount > 0 )
+	if ( bp->bounceSoundName[ 0 ] && p->bounceSoundCount > 0 && !particleBenchmarkRunning )
 	{
 		trap_S_StartSound( trace.endpos, ENTITYNUM_WORLD, soundChannel_t::CHAN_AUTO, bp->bounceSound );
 		p->bounceSoundCount--;
@@ -2384,6 +2653,344 @@ static void CG_EvaluateParticlePhysics( particle_t *p )
 	}
 }
 
+/*
+===============
+Particle simulation core
+
+Every frame the moving particles are gathered into structure-of-arrays
+form, grouped by base class within their ejector. Positions and
+velocities are then integrated in flat loops over the arrays, and each
+group's swept volume is tested against the world with a single box
+position test; only groups that touch something fall back to one
+trace per particle.
+===============
+*/
+
+// groups spanning more than this are traced per particle straight away
+#define PARTICLE_GROUP_MAX_EXTENT 512.0f
+#define PARTICLE_GROUP_KEYS       ( MAX_PARTICLE_EJECTORS * MAX_PARTICLES_PER_EJECTOR )
+
+static Cvar::Cvar<bool> cg_particleGroupCollision(
+	"cg_particleGroupCollision", "skip particle traces for groups whose swept volume is empty",
+	Cvar::NONE, true );
+
+struct particleSimulation_t
+{
+	int        numParticles;
+	particle_t *particle[ MAX_PARTICLES ];
+
+	float      originX[ MAX_PARTICLES ], originY[ MAX_PARTICLES ], originZ[ MAX_PARTICLES ];
+	float      velocityX[ MAX_PARTICLES ], velocityY[ MAX_PARTICLES ], velocityZ[ MAX_PARTICLES ];
+	float      accelX[ MAX_PARTICLES ], accelY[ MAX_PARTICLES ], accelZ[ MAX_PARTICLES ];
+	float      newX[ MAX_PARTICLES ], newY[ MAX_PARTICLES ], newZ[ MAX_PARTICLES ];
+	float      deltaTime[ MAX_PARTICLES ];
+
+	// particles [ groupStart[ i ], groupStart[ i + 1 ] ) share a base class and ejector
+	int        numGroups;
+	int        groupStart[ MAX_PARTICLES + 1 ];
+
+	// stats for the last simulated frame
+	int        numTraces;
+	int        numClearGroups;
+};
+
+static particleSimulation_t particleSim;
+static int                  particleSimKey[ MAX_PARTICLES ];
+static vec3_t               particleSimAccel[ MAX_PARTICLES ];
+static int                  particleSimBucket[ PARTICLE_GROUP_KEYS + 1 ];
+
+/*
+===============
+CG_ParticleGroupKey
+
+Key grouping particles by ejector and base class, or -1 if the particle
+doesn't need simulating this frame
+===============
+*/
+static int CG_ParticleGroupKey( particle_t *p )
+{
+	particleEjector_t *pe = p->parent;
+
+	if ( !p->valid || p->birthTime + p->lifeTime <= cg.time )
+	{
+		return -1;
+	}
+
+	if ( p->atRest )
+	{
+		VectorClear( p->velocity );
+		return -1;
+	}
+
+	//off-screen systems catch up once they're back in view
+	if ( pe->parent->culled && cg_particleLOD.Get() )
+	{
+		return -1;
+	}
+
+	for ( int i = 0; i < pe->class_->numParticles; i++ )
+	{
+		if ( pe->class_->particles[ i ] == p->class_ )
+		{
+			return ( int )( pe - particleEjectors ) * MAX_PARTICLES_PER_EJECTOR + i;
+		}
+	}
+
+	return ( int )( pe - particleEjectors ) * MAX_PARTICLES_PER_EJECTOR;
+}
+
+/*
+===============
+CG_GatherParticles
+
+Counting sort the moving particles into their groups
+===============
+*/
+static void CG_GatherParticles()
+{
+	particleSimulation_t *sim = &particleSim;
+	int                  i, key, total;
+
+	memset( particleSimBucket, 0, sizeof( particleSimBucket ) );
+
+	for ( i = 0; i < MAX_PARTICLES; i++ )
+	{
+		particle_t *p = &particles[ i ];
+
+		key = CG_ParticleGroupKey( p );
+		VectorClear( particleSimAccel[ i ] );
+
+		if ( key >= 0 && !CG_ParticleAcceleration( p, particleSimAccel[ i ] ) )
+		{
+			key = -1;
+		}
+
+		particleSimKey[ i ] = key;
+
+		if ( key >= 0 )
+		{
+			particleSimBucket[ key ]++;
+		}
+	}
+
+	sim->numGroups = 0;
+	total = 0;
+
+	for ( key = 0; key < PARTICLE_GROUP_KEYS; key++ )
+	{
+		int count = particleSimBucket[ key ];
+
+		if ( count )
+		{
+			sim->groupStart[ sim->numGroups++ ] = total;
+		}
+
+		particleSimBucket[ key ] = total;
+		total += count;
+	}
+
+	sim->groupStart[ sim->numGroups ] = total;
+	sim->numParticles = total;
+
+	for ( i = 0; i < MAX_PARTICLES; i++ )
+	{
+		particle_t *p = &particles[ i ];
+		int        slot;
+
+		if ( particleSimKey[ i ] < 0 )
+		{
+			continue;
+		}
+
+		slot = particleSimBucket[ particleSimKey[ i ] ]++;
+
+		sim->particle[ slot ] = p;
+		sim->originX[ slot ] = p->origin[ 0 ];
+		sim->originY[ slot ] = p->origin[ 1 ];
+		sim->originZ[ slot ] = p->origin[ 2 ];
+		sim->velocityX[ slot ] = p->velocity[ 0 ];
+		sim->velocityY[ slot ] = p->velocity[ 1 ];
+		sim->velocityZ[ slot ] = p->velocity[ 2 ];
+		sim->accelX[ slot ] = particleSimAccel[ i ][ 0 ];
+		sim->accelY[ slot ] = particleSimAccel[ i ][ 1 ];
+		sim->accelZ[ slot ] = particleSimAccel[ i ][ 2 ];
+		sim->deltaTime[ slot ] = ( float )( cg.time - p->lastEvalTime ) * 0.001f;
+	}
+}
+
+/*
+===============
+CG_IntegrateParticles
+
+Explicit Euler step over the gathered particles
+===============
+*/
+static void CG_IntegrateParticles()
+{
+	particleSimulation_t *sim = &particleSim;
+	const int            n = sim->numParticles;
+
+	for ( int i = 0; i < n; i++ )
+	{
+		sim->velocityX[ i ] += sim->deltaTime[ i ] * sim->accelX[ i ];
+		sim->velocityY[ i ] += sim->deltaTime[ i ] * sim->accelY[ i ];
+		sim->velocityZ[ i ] += sim->deltaTime[ i ] * sim->accelZ[ i ];
+	}
+
+	for ( int i = 0; i < n; i++ )
+	{
+		sim->newX[ i ] = sim->originX[ i ] + sim->deltaTime[ i ] * sim->velocityX[ i ];
+		sim->newY[ i ] = sim->originY[ i ] + sim->deltaTime[ i ] * sim->velocityY[ i ];
+		sim->newZ[ i ] = sim->originZ[ i ] + sim->deltaTime[ i ] * sim->velocityZ[ i ];
+	}
+
+	for ( int i = 0; i < n; i++ )
+	{
+		particle_t *p = sim->particle[ i ];
+
+		VectorSet( p->velocity, sim->velocityX[ i ], sim->velocityY[ i ], sim->velocityZ[ i ] );
+		p->lastEvalTime = cg.time;
+	}
+}
+
+/*
+===============
+CG_ParticleGroupIsClear
+
+Test whether the volume swept by a whole group of particles is free of
+solids, in which case none of them need tracing
+===============
+*/
+static bool CG_ParticleGroupIsClear( int start, int end, const float *radius )
+{
+	particleSimulation_t *sim = &particleSim;
+	particleSystem_t     *ps = sim->particle[ start ]->parent->parent;
+	vec3_t               mins, maxs, center, size, halfSize;
+	trace_t              trace;
+
+	ClearBounds( mins, maxs );
+
+	for ( int i = start; i < end; i++ )
+	{
+		mins[ 0 ] = std::min( mins[ 0 ], std::min( sim->originX[ i ], sim->newX[ i ] ) - radius[ i ] );
+		mins[ 1 ] = std::min( mins[ 1 ], std::min( sim->originY[ i ], sim->newY[ i ] ) - radius[ i ] );
+		mins[ 2 ] = std::min( mins[ 2 ], std::min( sim->originZ[ i ], sim->newZ[ i ] ) - radius[ i ] );
+		maxs[ 0 ] = std::max( maxs[ 0 ], std::max( sim->originX[ i ], sim->newX[ i ] ) + radius[ i ] );
+		maxs[ 1 ] = std::max( maxs[ 1 ], std::max( sim->originY[ i ], sim->newY[ i ] ) + radius[ i ] );
+		maxs[ 2 ] = std::max( maxs[ 2 ], std::max( sim->originZ[ i ], sim->newZ[ i ] ) + radius[ i ] );
+	}
+
+	VectorSubtract( maxs, mins, size );
+
+	if ( size[ 0 ] > PARTICLE_GROUP_MAX_EXTENT ||
+	     size[ 1 ] > PARTICLE_GROUP_MAX_EXTENT ||
+	     size[ 2 ] > PARTICLE_GROUP_MAX_EXTENT )
+	{
+		return false;
+	}
+
+	VectorScale( size, 0.5f, halfSize );
+	VectorAdd( mins, halfSize, center );
+	VectorNegate( halfSize, mins );
+
+	// a trace that doesn't move is a position test
+	CG_Trace( &trace, center, mins, halfSize, center, CG_AttachmentCentNum( &ps->attachment ),
+	          CONTENTS_SOLID, 0 );
+
+	return !trace.startsolid && !trace.allsolid;
+}
+
+/*
+===============
+CG_CollideParticles
+
+Move the integrated particles to their new origins
+===============
+*/
+static void CG_CollideParticles()
+{
+	particleSimulation_t *sim = &particleSim;
+	static float         radius[ MAX_PARTICLES ];
+	static float         bounce[ MAX_PARTICLES ];
+
+	sim->numTraces = 0;
+	sim->numClearGroups = 0;
+
+	// we're not doing particle physics, but at least cull them in solids
+	if ( !cg_bounceParticles.Get() )
+	{
+		for ( int i = 0; i < sim->numParticles; i++ )
+		{
+			particle_t *p = sim->particle[ i ];
+			vec3_t     newOrigin = { sim->newX[ i ], sim->newY[ i ], sim->newZ[ i ] };
+			int        contents = CM_PointContents( newOrigin, 0 );
+
+			if ( ( contents & CONTENTS_SOLID ) || ( contents & CONTENTS_NODROP ) )
+			{
+				CG_DestroyParticle( p, nullptr );
+			}
+			else
+			{
+				VectorCopy( newOrigin, p->origin );
+			}
+		}
+
+		return;
+	}
+
+	for ( int i = 0; i < sim->numParticles; i++ )
+	{
+		baseParticle_t *bp = sim->particle[ i ]->class_;
+
+		radius[ i ] = CG_ParticlePhysicsRadius( sim->particle[ i ] );
+		bounce[ i ] = CG_RandomiseValue( bp->bounceFrac, bp->bounceFracRandFrac );
+	}
+
+	for ( int group = 0; group < sim->numGroups; group++ )
+	{
+		int  start = sim->groupStart[ group ];
+		int  end = sim->groupStart[ group + 1 ];
+		bool clear = cg_particleGroupCollision.Get() && !particleGroupCollisionDisabled &&
+		             end - start > 1 &&
+		             CG_ParticleGroupIsClear( start, end, radius );
+
+		if ( clear )
+		{
+			sim->numClearGroups++;
+		}
+
+		for ( int i = start; i < end; i++ )
+		{
+			particle_t *p = sim->particle[ i ];
+			vec3_t     newOrigin = { sim->newX[ i ], sim->newY[ i ], sim->newZ[ i ] };
+
+			//not a collider
+			if ( clear || bounce[ i ] == 0.0f )
+			{
+				CG_MoveParticleFreely( p, newOrigin );
+				continue;
+			}
+
+			CG_SweepParticle( p, newOrigin, radius[ i ], bounce[ i ] );
+			sim->numTraces++;
+		}
+	}
+}
+
+/*
+===============
+CG_SimulateParticles
+
+Compute the physics on all the live particles
+===============
+*/
+static void CG_SimulateParticles()
+{
+	CG_GatherParticles();
+	CG_IntegrateParticles();
+	CG_CollideParticles();
+}
+
 #define GETKEY(x,y) ((( x ) >> (y) ) & 0xFF )
 
 /*
@@ -2508,7 +3115,7 @@ static void CG_RenderParticle( particle_t *p )
 	baseParticle_t       *bp = p->class_;
 	particleSystem_t     *ps = p->parent->parent;
 	baseParticleSystem_t *bps = ps->class_;
-	vec3_t               alight, dlight, lightdir;
+	vec3_t               alight;
 	vec3_t               up = { 0.0f, 0.0f, 1.0f };
 
 	refEntity_t re{};
@@ -2530,7 +3137,7 @@ static void CG_RenderParticle( particle_t *p )
 		//apply environmental lighting to the particle
 		if ( bp->realLight )
 		{
-			trap_R_LightForPoint( p->origin, alight, dlight, lightdir );
+			CG_AmbientLightForPoint( p->origin, alight );
 
 			re.shaderRGBA.SetRed( alight[0] );
 			re.shaderRGBA.SetGreen( alight[1] );
@@ -2681,12 +3288,18 @@ void CG_AddParticles()
 	//remove expired particle systems
 	CG_GarbageCollectParticleSystems();
 
+	//decide which systems get to eject and move
+	CG_ScheduleParticleSystems();
+
 	//check each ejector and introduce any new particles
 	CG_SpawnNewParticles();
 
 	//sorting
 	CG_CompactAndSortParticles();
 
+	//move everything that's still alive
+	CG_SimulateParticles();
+
 	for ( i = 0; i < MAX_PARTICLES; i++ )
 	{
 		p = sortedParticles[ i ];
@@ -2696,7 +3309,6 @@ void CG_AddParticles()
 			if ( p->birthTime + p->lifeTime > cg.time )
 			{
 				//particle is active
-				CG_EvaluateParticlePhysics( p );
 				CG_RenderParticle( p );
 			}
 			else
@@ -2732,7 +3344,12 @@ void CG_AddParticles()
 			}
 		}
 
-		Log::Debug( "PS: %d  PE: %d  P: %d", numPS, numPE, numP );
+		Log::Debug( "PS: %d  PE: %d  P: %d  moving: %d  groups: %d (%d clear)  traces: %d",
+		            numPS, numPE, numP, particleSim.numParticles, particleSim.numGroups,
+		            particleSim.numClearGroups, particleSim.numTraces );
+		Log::Debug( "budget: %d  load: %.2f  culled PS: %d  throttled PS: %d  evicted PS: %d",
+		            cg_particleBudget.Get(), particleSchedule.load, particleSchedule.numCulled,
+		            particleSchedule.numThrottled, particleSchedule.numEvicted );
 	}
 }
 
@@ -2775,7 +3392,6 @@ void CG_ParticleSystemEntity( centity_t *cent )
 	}
 }
 
-static particleSystem_t *testPS;
 static qhandle_t        testPSHandle;
 
 /*
@@ -2830,3 +3446,64 @@ void CG_TestPS_f()
 		}
 	}
 }
+
+/*
+===============
+CG_ParticleBenchmark_f
+
+Steps the live particles through a number of simulated frames, with and
+without the group collision tests, and reports the time spent. Marks,
+sounds and death systems are suppressed and the particles are restored
+afterwards, so spawn something with testPS first.
+===============
+*/
+void CG_ParticleBenchmark_f()
+{
+	int frames = 100;
+	int savedTime = cg.time;
+
+	if ( trap_Argc() > 1 )
+	{
+		frames = std::max( 1, atoi( CG_Argv( 1 ) ) );
+	}
+
+	std::vector<particle_t>        savedParticles( particles, particles + MAX_PARTICLES );
+	std::vector<particleEjector_t> savedEjectors( particleEjectors, particleEjectors + MAX_PARTICLE_EJECTORS );
+	std::vector<particleSystem_t>  savedSystems( particleSystems, particleSystems + MAX_PARTICLE_SYSTEMS );
+
+	particleBenchmarkRunning = true;
+
+	for ( int pass = 0; pass < 2; pass++ )
+	{
+		int simulated = 0, traces = 0;
+		int startTime;
+
+		particleGroupCollisionDisabled = ( pass == 0 );
+
+		// same random stream for both passes
+		srand( 0 );
+		startTime = trap_Milliseconds();
+
+		for ( int i = 0; i < frames; i++ )
+		{
+			cg.time += 16;
+			CG_SimulateParticles();
+
+			simulated += particleSim.numParticles;
+			traces += particleSim.numTraces;
+		}
+
+		Log::Notice( "%s: %d particle updates and %d traces over %d frames in %d msec",
+		             pass == 0 ? "per particle" : "grouped", simulated, traces, frames,
+		             trap_Milliseconds() - startTime );
+
+		cg.time = savedTime;
+		std::copy( savedParticles.begin(), savedParticles.end(), particles );
+		std::copy( savedEjectors.begin(), savedEjectors.end(), particleEjectors );
+		std::copy( savedSystems.begin(), savedSystems.end(), particleSystems );
+	}
+
+	particleGroupCollisionDisabled = false;
+	particleBenchmarkRunning = false;
+	srand( trap_Milliseconds() );
+}
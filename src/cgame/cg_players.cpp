@@ -1199,35 +1199,118 @@ NSPA_STAND, "idle", true, false, false )
 	return true;
 }
 
+/*
+======================
+CG_CopyClientInfoModel
+======================
+*/
+static void CG_CopyClientInfoModel( clientInfo_t *from, clientInfo_t *to )
+{
+	VectorCopy( from->headOffset, to->headOffset );
+	to->modelScale = from->modelScale;
+	to->footsteps = from->footsteps;
+	to->gender = from->gender;
+
+	to->legsModel = from->legsModel;
+	to->legsSkin = from->legsSkin;
+	to->torsoModel = from->torsoModel;
+	to->torsoSkin = from->torsoSkin;
+	to->headModel = from->headModel;
+	to->headSkin = from->headSkin;
+	to->nonSegModel = from->nonSegModel;
+	to->nonSegSkin = from->nonSegSkin;
+	to->nonsegmented = from->nonsegmented;
+	to->modelIcon = from->modelIcon;
+	to->bodyModel = from->bodyModel;
+	to->bodySkin = from->bodySkin;
+	to->skeletal = from->skeletal;
+	to->iqm = from->iqm;
+	to->fixedlegs = from->fixedlegs;
+	to->fixedtorso = from->fixedtorso;
+	to->modifiers = from->modifiers;
+
+	memcpy( to->animations, from->animations, sizeof( to->animations ) );
+	memcpy( to->sounds, from->sounds, sizeof( to->sounds ) );
+	memcpy( to->customFootsteps, from->customFootsteps, sizeof( to->customFootsteps ) );
+	memcpy( to->customMetalFootsteps, from->customMetalFootsteps, sizeof( to->customMetalFootsteps ) );
+}
+
+/*
+Player models are loaded in steps, the model with its skin and animations
+first and then each sound, so that the loading can be spread over frames.
+Each model and skin pair is loaded once, and every clientinfo using it
+copies the handles. Models queued with CG_QueueClientModel are loaded a
+few steps per frame, and anything needed before it is done finishes its
+remaining steps immediately.
+*/
+#define MAX_CLIENT_MODELS 32
+
+enum clientModelStep_t
+{
+	CMS_MODEL,
+	CMS_SOUNDS, // one step for each custom sound
+	CMS_FOOTSTEPS = CMS_SOUNDS + MAX_CUSTOM_SOUNDS,
+	CMS_DONE
+};
+
+struct clientModel_t
+{
+	bool         inUse;
+	int          step;
+	int          refs; // clientinfos holding its handles
+	int          modelMsec;
+	int          soundMsec;
+	clientInfo_t info;
+};
+
+static clientModel_t clientModels[ MAX_CLIENT_MODELS ];
+
+static Cvar::Range<Cvar::Cvar<int>> cg_modelLoadBudget(
+	"cg_modelLoadBudget", "milliseconds per frame spent loading queued player models (0 = load them when needed)",
+	Cvar::NONE, 0, 0, 100 );
+
+static struct
+{
+	int loaded;
+	int reused;
+	int immediateSteps;
+	int queuedSteps;
+	int queuedFrames;
+	int modelStepMsec; // slowest step of each kind so far
+	int soundStepMsec;
+} clientModelStats;
+
 /*
 ===================
-CG_LoadClientInfo
+CG_LoadClientInfoStep
 
-Load it now, taking the disk hits
+Runs one loading step for a clientinfo, taking the disk hits
 ===================
 */
-static void CG_LoadClientInfo( clientInfo_t *ci )
+static void CG_LoadClientInfoStep( clientInfo_t *ci, int step )
 {
-	const char *dir;
-	int        i;
+	const char *dir = ci->modelName;
 	const char *s;
-	int        clientNum;
 
-	if ( !CG_RegisterClientModelname( ci, ci->modelName, ci->skinName ) )
+	if ( step == CMS_MODEL )
 	{
-		Sys::Drop( "CG_RegisterClientModelname( %s, %s ) failed", ci->modelName, ci->skinName );
-	}
+		if ( !CG_RegisterClientModelname( ci, ci->modelName, ci->skinName ) )
+		{
+			Sys::Drop( "CG_RegisterClientModelname( %s, %s ) failed", ci->modelName, ci->skinName );
+		}
 
-	// sounds
-	dir = ci->modelName;
+		return;
+	}
 
-	for ( i = 0; i < MAX_CUSTOM_SOUNDS; i++ )
+	if ( step < CMS_FOOTSTEPS )
 	{
+		int i = step - CMS_SOUNDS;
+
 		s = cg_customSoundNames[ i ];
 
 		if ( !s )
 		{
-			break;
+			return;
 		}
 
 		ci->sounds[ i ] = trap_S_RegisterSound( va( "sound/player/%s/%s", dir, s + 1 ), false );
@@ -1253,11 +1336,13 @@ static void CG_LoadClientInfo( clientInfo_t *ci )
 				ci->sounds[ i ] = trap_S_RegisterSound( va( "sound/player/%s/%s", dir, s + 1 ), false );
 			}
 		}
+
+		return;
 	}
 
 	if ( ci->footsteps == FOOTSTEP_CUSTOM )
 	{
-		for ( i = 0; i < 4; i++ )
+		for ( int i = 0; i < 4; i++ )
 		{
 			ci->customFootsteps[ i ] = trap_S_RegisterSound( va( "sound/player/%s/step%d", dir, i + 1 ), false );
 
@@ -1274,6 +1359,224 @@ static void CG_LoadClientInfo( clientInfo_t *ci )
 			}
 		}
 	}
+}
+
+/*
+===================
+CG_RunClientModelStep
+===================
+*/
+static void CG_RunClientModelStep( clientModel_t *cm )
+{
+	int start = trap_Milliseconds();
+	int msec;
+
+	CG_LoadClientInfoStep( &cm->info, cm->step );
+
+	msec = trap_Milliseconds() - start;
+
+	if ( cm->step == CMS_MODEL )
+	{
+		cm->modelMsec += msec;
+		clientModelStats.modelStepMsec = std::max( clientModelStats.modelStepMsec, msec );
+	}
+	else
+	{
+		cm->soundMsec += msec;
+		clientModelStats.soundStepMsec = std::max( clientModelStats.soundStepMsec, msec );
+	}
+
+	if ( ++cm->step == CMS_DONE )
+	{
+		clientModelStats.loaded++;
+	}
+}
+
+/*
+===================
+CG_FindClientModel
+
+Finds the entry for a model and skin, or starts a new one if there is room
+===================
+*/
+static clientModel_t *CG_FindClientModel( const char *modelName, const char *skinName, bool create )
+{
+	clientModel_t *unused = nullptr;
+
+	for ( clientModel_t &cm : clientModels )
+	{
+		if ( !cm.inUse )
+		{
+			if ( !unused )
+			{
+				unused = &cm;
+			}
+
+			continue;
+		}
+
+		if ( !Q_stricmp( cm.info.modelName, modelName ) && !Q_stricmp( cm.info.skinName, skinName ) )
+		{
+			return &cm;
+		}
+	}
+
+	if ( !create || !unused )
+	{
+		return nullptr;
+	}
+
+	*unused = {};
+	unused->inUse = true;
+	unused->step = CMS_MODEL;
+	Q_strncpyz( unused->info.modelName, modelName, sizeof( unused->info.modelName ) );
+	Q_strncpyz( unused->info.skinName, skinName, sizeof( unused->info.skinName ) );
+
+	return unused;
+}
+
+/*
+===================
+CG_QueueClientModel
+
+Loads a model and skin over the next frames, ahead of when it is needed.
+Does nothing without a cg_modelLoadBudget, the model is then loaded when
+it is first needed.
+===================
+*/
+void CG_QueueClientModel( const char *modelName, const char *skinName )
+{
+	if ( !cg_modelLoadBudget.Get() )
+	{
+		return;
+	}
+
+	CG_FindClientModel( modelName, skinName ? skinName : "default", true );
+}
+
+/*
+===================
+CG_RunClientModelQueue
+
+Called every frame to load queued models within cg_modelLoadBudget. A
+step is only run when the slowest step of its kind so far fits in the
+time left, so steps that never fit are left for when the model is needed.
+===================
+*/
+void CG_RunClientModelQueue()
+{
+	int  budget = cg_modelLoadBudget.Get();
+	int  start = trap_Milliseconds();
+	bool ran = false;
+
+	if ( !budget )
+	{
+		return;
+	}
+
+	for ( clientModel_t &cm : clientModels )
+	{
+		while ( cm.inUse && cm.step != CMS_DONE )
+		{
+			int left = budget - ( trap_Milliseconds() - start );
+			int cost = cm.step == CMS_MODEL ? clientModelStats.modelStepMsec : clientModelStats.soundStepMsec;
+
+			if ( left <= 0 || cost > left )
+			{
+				if ( ran )
+				{
+					clientModelStats.queuedFrames++;
+				}
+
+				return;
+			}
+
+			CG_RunClientModelStep( &cm );
+			clientModelStats.queuedSteps++;
+			ran = true;
+		}
+	}
+
+	if ( ran )
+	{
+		clientModelStats.queuedFrames++;
+	}
+}
+
+/*
+===================
+CG_ClientModelStats
+
+Print how long the player models took to load
+===================
+*/
+void CG_ClientModelStats()
+{
+	int modelMsec = 0, soundMsec = 0, pending = 0;
+
+	for ( const clientModel_t &cm : clientModels )
+	{
+		if ( !cm.inUse )
+		{
+			continue;
+		}
+
+		if ( cm.step != CMS_DONE )
+		{
+			pending++;
+		}
+
+		modelMsec += cm.modelMsec;
+		soundMsec += cm.soundMsec;
+
+		Log::Verbose( "player model %s/%s: %d users, models and animations %dms, sounds %dms%s",
+		              cm.info.modelName, cm.info.skinName, cm.refs, cm.modelMsec, cm.soundMsec,
+		              cm.step == CMS_DONE ? "" : ", still queued" );
+	}
+
+	Log::Notice( "%d player models loaded (%d queued), models and animations %dms, sounds %dms, %d reused",
+	             clientModelStats.loaded, pending, modelMsec, soundMsec, clientModelStats.reused );
+	Log::Verbose( "%d loading steps run when needed, %d over %d frames from the queue",
+	              clientModelStats.immediateSteps, clientModelStats.queuedSteps, clientModelStats.queuedFrames );
+}
+
+/*
+===================
+CG_LoadClientInfo
+
+Load it now, taking the disk hits
+===================
+*/
+static void CG_LoadClientInfo( clientInfo_t *ci )
+{
+	clientModel_t *cm = CG_FindClientModel( ci->modelName, ci->skinName, true );
+	int           i;
+	int           clientNum;
+
+	if ( cm )
+	{
+		if ( cm->step == CMS_DONE )
+		{
+			clientModelStats.reused++;
+		}
+
+		while ( cm->step != CMS_DONE )
+		{
+			CG_RunClientModelStep( cm );
+			clientModelStats.immediateSteps++;
+		}
+
+		CG_CopyClientInfoModel( &cm->info, ci );
+		cm->refs++;
+	}
+	else
+	{
+		// no room to keep it, so load it straight into the clientinfo
+		for ( i = CMS_MODEL; i < CMS_DONE; i++ )
+		{
+			CG_LoadClientInfoStep( ci, i );
+		}
+	}
 
 	// reset any existing players and bodies, because they might be in bad
 	// frames for this new model
@@ -1290,37 +1593,27 @@ static void CG_LoadClientInfo( clientInfo_t *ci )
 }
 
 /*
-======================
-CG_CopyClientInfoModel
-======================
+===================
+CG_ReleaseClientInfo
+
+A clientinfo stops using its model
+===================
 */
-static void CG_CopyClientInfoModel( clientInfo_t *from, clientInfo_t *to )
+static void CG_ReleaseClientInfo( const clientInfo_t *ci )
 {
-	VectorCopy( from->headOffset, to->headOffset );
-	to->modelScale = from->modelScale;
-	to->footsteps = from->footsteps;
-	to->gender = from->gender;
+	clientModel_t *cm;
 
-	to->legsModel = from->legsModel;
-	to->legsSkin = from->legsSkin;
-	to->torsoModel = from->torsoModel;
-	to->torsoSkin = from->torsoSkin;
-	to->headModel = from->headModel;
-	to->headSkin = from->headSkin;
-	to->nonSegModel = from->nonSegModel;
-	to->nonSegSkin = from->nonSegSkin;
-	to->nonsegmented = from->nonsegmented;
-	to->modelIcon = from->modelIcon;
-	to->bodyModel = from->bodyModel;
-	to->bodySkin = from->bodySkin;
-	to->skeletal = from->skeletal;
-	to->iqm = from->iqm;
-	to->modifiers = from->modifiers;
+	if ( !ci->infoValid )
+	{
+		return;
+	}
 
-	memcpy( to->animations, from->animations, sizeof( to->animations ) );
-	memcpy( to->sounds, from->sounds, sizeof( to->sounds ) );
-	memcpy( to->customFootsteps, from->customFootsteps, sizeof( to->customFootsteps ) );
-	memcpy( to->customMetalFootsteps, from->customMetalFootsteps, sizeof( to->customMetalFootsteps ) );
+	cm = CG_FindClientModel( ci->modelName, ci->skinName, false );
+
+	if ( cm && cm->refs > 0 )
+	{
+		cm->refs--;
+	}
 }
 
 /*
@@ -1380,9 +1673,17 @@ static bool CG_ScanForExistingClientInfo( clientInfo_t *ci )
 		     !Q_stricmp( ci->modelName, match->modelName ) &&
 		     !Q_stricmp( ci->skinName, match->skinName ) )
 		{
+			clientModel_t *cm = CG_FindClientModel( ci->modelName, ci->skinName, false );
+
 			// this clientinfo is identical, so use its handles
 			CG_CopyClientInfoModel( match, ci );
 
+			if ( cm )
+			{
+				cm->refs++;
+			}
+
+			clientModelStats.reused++;
 			return true;
 		}
 	}
@@ -1421,6 +1722,7 @@ void CG_PrecacheClientInfo( class_t class_, const char *model, const char *skin
 	newInfo.infoValid = true;
 
 	// actually register the models
+	CG_ReleaseClientInfo( ci );
 	*ci = newInfo;
 	CG_LoadClientInfo( ci );
 }
@@ -1482,6 +1784,7 @@ void CG_NewClientInfo( int clientNum )
 
 	if ( !configstring[ 0 ] )
 	{
+		CG_ReleaseClientInfo( ci );
 		*ci = {};
 		return; // player just left
 	}
@@ -1530,6 +1833,7 @@ void CG_NewClientInfo( int clientNum )
 
 	// replace whatever was there with the new one
 	newInfo.infoValid = true;
+	CG_ReleaseClientInfo( ci );
 	*ci = newInfo;
 
 	// scan for an existing clientinfo that matches this modelname
@@ -1701,7 +2005,7 @@ static void CG_RunCorpseLerpFrame( clientInfo_t *ci, lerpFrame_t *lf, int newAni
 
 	if ( lf->animation )
 	{
-		if ( !trap_R_BuildSkeleton( &legsSkeleton, lf->animation->handle, anim->numFrames - 1, anim->numFrames - 1, 0, lf->animation->clearOrigin ) )
+		if ( !CG_BuildSkeleton( &legsSkeleton, lf->animation->handle, anim->numFrames - 1, anim->numFrames - 1, 0, lf->animation->clearOrigin ) )
 		{
 			Log::Warn( "Can't build lf->skeleton" );
 		}
@@ -2577,6 +2881,75 @@ static void CG_PlayerSprites( centity_t *cent )
 	}
 }
 
+static Cvar::Range<Cvar::Cvar<float>> cg_groundProbeDistance(
+	"cg_groundProbeDistance", "reuse a player's shadow and wake traces until it moves this far (0 = trace every frame)",
+	Cvar::NONE, 2.0f, 0.0f, 16.0f );
+
+// traces are redone at least this often, in case the ground itself moved
+#define GROUND_PROBE_MAX_AGE 250
+
+/*
+===============
+CG_GroundProbeValid
+
+Whether traces made at some time and place can stand in for new ones
+===============
+*/
+static bool CG_GroundProbeValid( const centity_t *cent, int time, const vec3_t origin )
+{
+	float distance = cg_groundProbeDistance.Get();
+
+	return time && cg.time >= time && cg.time - time < GROUND_PROBE_MAX_AGE &&
+	       DistanceSquared( cent->lerpOrigin, origin ) <= Square( distance ) && distance > 0.0f;
+}
+
+#define SHADOW_DISTANCE 128
+
+/*
+===============
+CG_ShadowTrace
+
+Trace from the player to the ground below it, or reuse the last trace
+moved along with the player if it has barely moved
+===============
+*/
+static void CG_ShadowTrace( centity_t *cent, class_t class_, const vec3_t mins, const vec3_t maxs,
+                            const vec3_t surfNormal, trace_t *trace )
+{
+	groundProbe_t *probe = &cent->groundProbe;
+	vec3_t        end, delta;
+	float         rise;
+
+	if ( probe->shadowClass == class_ && VectorCompare( probe->shadowNormal, surfNormal ) &&
+	     CG_GroundProbeValid( cent, probe->shadowTime, probe->shadowOrigin ) )
+	{
+		*trace = probe->shadowTrace;
+
+		if ( trace->fraction < 1.0f && !trace->startsolid && !trace->allsolid )
+		{
+			// slide the hit along the ground, moving away from it lengthens the trace
+			VectorSubtract( cent->lerpOrigin, probe->shadowOrigin, delta );
+			rise = DotProduct( delta, surfNormal );
+			VectorAdd( trace->endpos, delta, trace->endpos );
+			VectorMA( trace->endpos, -rise, surfNormal, trace->endpos );
+			trace->fraction = std::min( 1.0f, trace->fraction + rise / SHADOW_DISTANCE );
+		}
+
+		return;
+	}
+
+	// send a trace down from the player to the ground
+	VectorMA( cent->lerpOrigin, -SHADOW_DISTANCE, surfNormal, end );
+
+	CM_BoxTrace( trace, cent->lerpOrigin, end, mins, maxs, 0, MASK_PLAYERSOLID, 0, traceType_t::TT_AABB );
+
+	probe->shadowTime = cg.time;
+	probe->shadowClass = class_;
+	VectorCopy( cent->lerpOrigin, probe->shadowOrigin );
+	VectorCopy( surfNormal, probe->shadowNormal );
+	probe->shadowTrace = *trace;
+}
+
 /*
 ===============
 CG_PlayerShadow
@@ -2586,10 +2959,9 @@ Returns the Z component of the surface being shadowed
   should it return a full plane instead of a Z?
 ===============
 */
-#define SHADOW_DISTANCE 128
 static bool CG_PlayerShadow( centity_t *cent, class_t class_ )
 {
-	vec3_t        end, mins, maxs;
+	vec3_t        mins, maxs;
 	trace_t       trace;
 	float         alpha;
 	entityState_t *es = &cent->currentState;
@@ -2616,11 +2988,7 @@ static bool CG_PlayerShadow( centity_t *cent, class_t class_ )
 		return false;
 	}
 
-	// send a trace down from the player to the ground
-	VectorCopy( cent->lerpOrigin, end );
-	VectorMA( cent->lerpOrigin, -SHADOW_DISTANCE, surfNormal, end );
-
-	CM_BoxTrace( &trace, cent->lerpOrigin, end, mins, maxs, 0, MASK_PLAYERSOLID, 0, traceType_t::TT_AABB );
+	CG_ShadowTrace( cent, class_, mins, maxs, surfNormal, &trace );
 
 	// no shadow if too high
 	if ( trace.fraction == 1.0 || trace.startsolid || trace.allsolid )
@@ -2646,9 +3014,9 @@ static bool CG_PlayerShadow( centity_t *cent, class_t class_ )
 
 	// add the mark as a temporary, so it goes directly to the renderer
 	// without taking a spot in the cg_marks array
-	CG_ImpactMark( cgs.media.shadowMarkShader, trace.endpos, trace.plane.normal,
-	               cent->pe.legs.yawAngle, 0.0f, 0.0f, 0.0f, alpha, false,
-	               24.0f * BG_ClassModelConfig( class_ )->shadowScale, true );
+	CG_GroundMark( cgs.media.shadowMarkShader, trace.endpos, trace.plane.normal,
+	               cent->pe.legs.yawAngle, 0.0f, 0.0f, 0.0f, alpha,
+	               24.0f * BG_ClassModelConfig( class_ )->shadowScale );
 
 	return true;
 }
@@ -2675,16 +3043,39 @@ Draw a mark at the water surface
 */
 static void CG_PlayerSplash( centity_t *cent, class_t class_ )
 {
-	vec3_t  start, end;
-	vec3_t  mins, maxs;
-	trace_t trace;
-	int     contents;
+	groundProbe_t *probe = &cent->groundProbe;
+	vec3_t        start, end;
+	vec3_t        mins, maxs;
+	trace_t       trace;
+	int           contents;
 
 	if ( cg_shadows == shadowingMode_t::SHADOWING_NONE)
 	{
 		return;
 	}
 
+	if ( probe->splashClass == class_ && CG_GroundProbeValid( cent, probe->splashTime, probe->splashOrigin ) )
+	{
+		if ( probe->splash )
+		{
+			// the surface is level, so only follow the player sideways
+			VectorCopy( probe->splashPoint, end );
+			end[ 0 ] += cent->lerpOrigin[ 0 ] - probe->splashOrigin[ 0 ];
+			end[ 1 ] += cent->lerpOrigin[ 1 ] - probe->splashOrigin[ 1 ];
+
+			CG_GroundMark( cgs.media.wakeMarkShader, end, probe->splashNormal,
+			               cent->pe.legs.yawAngle, 1.0f, 1.0f, 1.0f, 1.0f,
+			               32.0f * BG_ClassModelConfig( class_ )->shadowScale );
+		}
+
+		return;
+	}
+
+	probe->splashTime = cg.time;
+	probe->splashClass = class_;
+	probe->splash = false;
+	VectorCopy( cent->lerpOrigin, probe->splashOrigin );
+
 	BG_ClassBoundingBox( class_, mins, maxs, nullptr, nullptr, nullptr );
 
 	VectorCopy( cent->lerpOrigin, end );
@@ -2718,13 +3109,89 @@ static void CG_PlayerSplash( centity_t *cent, class_t class_ )
 		return;
 	}
 
-	CG_ImpactMark( cgs.media.wakeMarkShader, trace.endpos, trace.plane.normal,
-	               cent->pe.legs.yawAngle, 1.0f, 1.0f, 1.0f, 1.0f, false,
-	               32.0f * BG_ClassModelConfig( class_ )->shadowScale, true );
+	probe->splash = true;
+	VectorCopy( trace.endpos, probe->splashPoint );
+	VectorCopy( trace.plane.normal, probe->splashNormal );
+
+	CG_GroundMark( cgs.media.wakeMarkShader, trace.endpos, trace.plane.normal,
+	               cent->pe.legs.yawAngle, 1.0f, 1.0f, 1.0f, 1.0f,
+	               32.0f * BG_ClassModelConfig( class_ )->shadowScale );
 }
 
 #define TRACE_DEPTH    32.0f
 
+/*
+===============
+CG_PlayerDeadParticleSystems
+
+Sanity check that particle systems are stopped when dead
+===============
+*/
+static void CG_PlayerDeadParticleSystems( centity_t *cent )
+{
+	if ( !( cent->currentState.eFlags & EF_DEAD ) )
+	{
+		return;
+	}
+
+	if ( CG_IsParticleSystemValid( &cent->muzzlePS ) )
+	{
+		CG_DestroyParticleSystem( &cent->muzzlePS );
+	}
+
+	if ( CG_IsParticleSystemValid( &cent->jetPackPS[ 0 ] ) )
+	{
+		CG_DestroyParticleSystem( &cent->jetPackPS[ 0 ] );
+	}
+
+	if ( CG_IsParticleSystemValid( &cent->jetPackPS[ 1 ] ) )
+	{
+		CG_DestroyParticleSystem( &cent->jetPackPS[ 1 ] );
+	}
+}
+
+/*
+===============
+CG_CulledPlayer
+
+What is left of CG_Player for a player out of view: the sounds it makes,
+the light of its muzzle flash and its particle systems being stopped
+===============
+*/
+static void CG_CulledPlayer( centity_t *cent )
+{
+	entityState_t *es = &cent->currentState;
+
+	if ( es->weapon != WP_NONE )
+	{
+		CG_AddPlayerWeaponSounds( nullptr, cent );
+
+		// there is no tag_flash to place it on, the origin is close enough
+		CG_AddPlayerWeaponFlashLight( cent, cent->lerpOrigin );
+	}
+
+	if ( ( es->modelindex & ( 1 << UP_JETPACK ) ) && ( es->modelindex2 & PF_JETPACK_ACTIVE ) )
+	{
+		trap_S_AddLoopingSound( es->number, cent->lerpOrigin,
+		                        vec3_origin, cgs.media.jetpackThrustLoopSound );
+	}
+	else if ( cent->jetPackState == JPS_ACTIVE )
+	{
+		// the thrust is spawned again once the player is in view
+		for ( int i = 0; i < 2; i++ )
+		{
+			if ( CG_IsParticleSystemValid( &cent->jetPackPS[ i ] ) )
+			{
+				CG_DestroyParticleSystem( &cent->jetPackPS[ i ] );
+			}
+		}
+
+		cent->jetPackState = JPS_INACTIVE;
+	}
+
+	CG_PlayerDeadParticleSystems( cent );
+}
+
 /*
 ===============
 CG_Player
@@ -2737,7 +3204,8 @@ void CG_Player( centity_t *cent )
 	int           clientNum;
 	int           renderfx;
 	entityState_t *es = &cent->currentState;
-	class_t       class_ = (class_t) ( ( es->misc >> 8 ) & 0xFF );
+	const renderCache_t *rc = CG_RenderCache( cent );
+	class_t       class_ = rc->class_;
 	float         scale;
 	vec3_t        tempAxis[ 3 ], tempAxis2[ 3 ];
 	vec3_t        angles;
@@ -2771,6 +3239,13 @@ void CG_Player( centity_t *cent )
 		return;
 	}
 
+	// out of view, keep only what can be heard
+	if ( cent->culled )
+	{
+		CG_CulledPlayer( cent );
+		return;
+	}
+
 	if ( es->eFlags & EF_DEAD )
 	{
 		altShaderIndex = CG_ALTSHADER_DEAD;
@@ -2795,7 +3270,8 @@ void CG_Player( centity_t *cent )
 	{
 		vec3_t mins, maxs;
 
-		BG_ClassBoundingBox( class_, mins, maxs, nullptr, nullptr, nullptr );
+		VectorCopy( rc->mins, mins );
+		VectorCopy( rc->maxs, maxs );
 		CG_DrawBoundingBox( cg_drawBBOX.Get(), cent->lerpOrigin, mins, maxs );
 	}
 
@@ -2944,7 +3420,7 @@ void CG_Player( centity_t *cent )
 			legs.origin[ 0 ] -= ci->headOffset[ 0 ];
 			legs.origin[ 1 ] -= ci->headOffset[ 1 ];
 			legs.origin[ 2 ] -= 22 + ci->headOffset[ 2 ];
-			VectorMA( legs.origin, BG_ClassModelConfig( class_ )->zOffset, surfNormal, legs.origin );
+			VectorMA( legs.origin, rc->zOffset, surfNormal, legs.origin );
 		}
 
 		VectorCopy( legs.origin, legs.lightingOrigin );
@@ -3108,7 +3584,7 @@ void CG_Player( centity_t *cent )
 	}
 
 	//rescale the model
-	scale = BG_ClassModelConfig( class_ )->modelScale;
+	scale = rc->modelScale;
 
 	if ( scale != 1.0f )
 	{
@@ -3120,7 +3596,7 @@ void CG_Player( centity_t *cent )
 	}
 
 	//offset on the Z axis if required
-	VectorMA( legs.origin, BG_ClassModelConfig( class_ )->zOffset, surfNormal, legs.origin );
+	VectorMA( legs.origin, rc->zOffset, surfNormal, legs.origin );
 	VectorCopy( legs.origin, legs.lightingOrigin );
 	VectorCopy( legs.origin, legs.oldorigin );  // don't positionally lerp at all
 
@@ -3205,24 +3681,7 @@ void CG_Player( centity_t *cent )
 	CG_PlayerUpgrades( cent, &torso );
 
 finish_up:
-	//sanity check that particle systems are stopped when dead
-	if ( es->eFlags & EF_DEAD )
-	{
-		if ( CG_IsParticleSystemValid( &cent->muzzlePS ) )
-		{
-			CG_DestroyParticleSystem( &cent->muzzlePS );
-		}
-
-		if ( CG_IsParticleSystemValid( &cent->jetPackPS[ 0 ] ) )
-		{
-			CG_DestroyParticleSystem( &cent->jetPackPS[ 0 ] );
-		}
-
-		if ( CG_IsParticleSystemValid( &cent->jetPackPS[ 1 ] ) )
-		{
-			CG_DestroyParticleSystem( &cent->jetPackPS[ 1 ] );
-		}
-	}
+	CG_PlayerDeadParticleSystems( cent );
 
 	VectorCopy( surfNormal, cent->pe.lastNormal );
 	CG_PlayerShadowEnd( );
@@ -3237,6 +3696,7 @@ void CG_Corpse( centity_t *cent )
 {
 	clientInfo_t  *ci;
 	entityState_t *es = &cent->currentState;
+	const renderCache_t *rc = CG_RenderCache( cent );
 	int           renderfx;
 	vec3_t        origin, liveZ, deadZ, deadMax;
 	float         scale;
@@ -3249,6 +3709,11 @@ void CG_Corpse( centity_t *cent )
 		return;
 	}
 
+	if ( cent->culled )
+	{
+		return;
+	}
+
 	refEntity_t legs{}, torso{}, head{};
 
 	VectorCopy( cent->lerpOrigin, origin );
@@ -3351,11 +3816,11 @@ void CG_Corpse( centity_t *cent )
 
 	VectorCopy( origin, legs.lightingOrigin );
 	legs.renderfx = renderfx;
-	legs.origin[ 2 ] += BG_ClassModelConfig( es->clientNum )->zOffset;
+	legs.origin[ 2 ] += rc->zOffset;
 	VectorCopy( legs.origin, legs.oldorigin );  // don't positionally lerp at all
 
 	//rescale the model
-	scale = BG_ClassModelConfig( es->clientNum )->modelScale;
+	scale = rc->modelScale;
 
 	if ( scale != 1.0f && !ci->skeletal )
 	{
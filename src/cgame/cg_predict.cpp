@@ -36,6 +36,291 @@ static  pmove_t   cg_pmove;
 static BoundedVector<centity_t *, MAX_GENTITIES> cg_solidEntities;
 static BoundedVector<centity_t *, MAX_GENTITIES> cg_triggerEntities;
 
+static Cvar::Cvar<bool> cg_solidEntityGrid("cg_solidEntityGrid", "use a spatial index for client-side entity traces", Cvar::NONE, true);
+
+/*
+ * Broadphase for CG_ClipMoveToEntities.
+ *
+ * Box entities that can only move within known bounds until the next
+ * snapshot (stationary or interpolated, not riding a mover) are hashed into a
+ * uniform grid on the horizontal plane. Everything else, including all
+ * bmodels, goes to a list that is tested by every trace. Candidates are
+ * visited in solid list order so the result is identical to a linear scan.
+ */
+#define SOLID_GRID_CELL_SHIFT   8 // 256 units per cell
+#define SOLID_GRID_BUCKETS      1024 // must be a power of two
+#define SOLID_GRID_MAX_CELLS    16 // per entity, above that it is unindexed
+#define SOLID_GRID_MAX_QUERY    64 // cells per query, above that scan everything
+
+struct solidGrid_t
+{
+	int  frame; // cg.clientFrame the grid was built for, -1 when dirty
+
+	// per solid list index
+	vec3_t boxMins[ MAX_GENTITIES ], boxMaxs[ MAX_GENTITIES ]; // relative bbox
+	int    queryStamp[ MAX_GENTITIES ];
+
+	int    bucketStart[ SOLID_GRID_BUCKETS + 1 ];
+	std::vector<int> bucketItems;
+
+	BoundedVector<int, MAX_GENTITIES> unindexed;
+	BoundedVector<int, MAX_GENTITIES> bmodels; // for CG_PointContents
+
+	std::vector<int> candidates;
+	int    stamp;
+};
+
+static solidGrid_t cg_solidGrid = { -1 };
+static bool cg_solidGridDisabled; // set by the prediction benchmark
+
+// index in cg_solidEntities by entity number, -1 if not solid
+static int cg_solidListIndex[ MAX_GENTITIES ];
+
+// while set, CG_ClipMoveToEntities and CG_PointContents record the entities
+// they test against
+static predictionInputs_t *cg_predictionRecord;
+
+// commands that touched more than MAX_PREDICTION_TOUCHES entities, since
+// the cgame started
+static int cg_predictionTouchOverflows;
+
+static inline int CG_SolidGridCell( float v )
+{
+	return static_cast<int>( floorf( v ) ) >> SOLID_GRID_CELL_SHIFT;
+}
+
+static inline int CG_SolidGridBucket( int x, int y )
+{
+	return ( ( static_cast<unsigned>( x ) * 73856093u ) ^ ( static_cast<unsigned>( y ) * 19349663u ) ) & ( SOLID_GRID_BUCKETS - 1 );
+}
+
+/*
+====================
+CG_SolidEntityBox
+
+Bounding box of a non-bmodel solid entity, relative to its origin
+====================
+*/
+static void CG_SolidEntityBox( const entityState_t *ent, vec3_t bmins, vec3_t bmaxs )
+{
+	if ( ent->eType == entityType_t::ET_BUILDABLE )
+	{
+		BG_BuildableBoundingBox( ent->modelindex, bmins, bmaxs );
+	}
+	else
+	{
+		// encoded bbox
+		int x = ( ent->solid & 255 );
+		int zd = ( ( ent->solid >> 8 ) & 255 );
+		int zu = ( ( ent->solid >> 16 ) & 255 ) - 32;
+
+		bmins[ 0 ] = bmins[ 1 ] = -x;
+		bmaxs[ 0 ] = bmaxs[ 1 ] = x;
+		bmins[ 2 ] = -zd;
+		bmaxs[ 2 ] = zu;
+	}
+}
+
+/*
+====================
+CG_SolidEntitySweptBounds
+
+Computes the horizontal area an entity can occupy until the next snapshot.
+Returns false if that area cannot be bounded, e.g. for extrapolated
+entities or entities riding a mover.
+====================
+*/
+static bool CG_SolidEntitySweptBounds( const centity_t *cent, const vec3_t bmins, const vec3_t bmaxs,
+                                       vec3_t mins, vec3_t maxs )
+{
+	const entityState_t *ent = &cent->currentState;
+	vec3_t              point;
+
+	if ( ent->pos.trType != trType_t::TR_STATIONARY && ent->pos.trType != trType_t::TR_INTERPOLATE )
+	{
+		return false;
+	}
+
+	if ( ent->groundEntityNum != ENTITYNUM_NONE && ent->groundEntityNum != ENTITYNUM_WORLD )
+	{
+		return false;
+	}
+
+	ClearBounds( mins, maxs );
+	AddPointToBounds( cent->lerpOrigin, mins, maxs );
+	AddPointToBounds( ent->origin, mins, maxs );
+
+	BG_EvaluateTrajectory( &ent->pos, cg.snap->serverTime, point );
+	AddPointToBounds( point, mins, maxs );
+
+	if ( cg.nextSnap )
+	{
+		BG_EvaluateTrajectory( &cent->nextState.pos, cg.nextSnap->serverTime, point );
+		AddPointToBounds( point, mins, maxs );
+	}
+
+	VectorAdd( mins, bmins, mins );
+	VectorAdd( maxs, bmaxs, maxs );
+
+	return true;
+}
+
+/*
+====================
+CG_BuildSolidGrid
+====================
+*/
+static void CG_BuildSolidGrid()
+{
+	solidGrid_t &grid = cg_solidGrid;
+	int         cellBounds[ MAX_GENTITIES ][ 4 ];
+
+	grid.frame = cg.clientFrame;
+	grid.unindexed.clear();
+	grid.bmodels.clear();
+	memset( grid.bucketStart, 0, sizeof( grid.bucketStart ) );
+
+	// first pass: classify and count the entries of every bucket
+	for ( unsigned i = 0; i < cg_solidEntities.size(); i++ )
+	{
+		const centity_t *cent = cg_solidEntities[ i ];
+		vec3_t          mins, maxs;
+		int             *cells = cellBounds[ i ];
+
+		grid.queryStamp[ i ] = 0;
+		cells[ 0 ] = 1; // mark as not indexed
+		cells[ 2 ] = 0;
+
+		if ( cent->currentState.solid == SOLID_BMODEL )
+		{
+			grid.bmodels.append( i );
+			grid.unindexed.append( i );
+			continue;
+		}
+
+		CG_SolidEntityBox( &cent->currentState, grid.boxMins[ i ], grid.boxMaxs[ i ] );
+
+		if ( !CG_SolidEntitySweptBounds( cent, grid.boxMins[ i ], grid.boxMaxs[ i ], mins, maxs ) )
+		{
+			grid.unindexed.append( i );
+			continue;
+		}
+
+		cells[ 0 ] = CG_SolidGridCell( mins[ 0 ] );
+		cells[ 1 ] = CG_SolidGridCell( mins[ 1 ] );
+		cells[ 2 ] = CG_SolidGridCell( maxs[ 0 ] );
+		cells[ 3 ] = CG_SolidGridCell( maxs[ 1 ] );
+
+		if ( ( cells[ 2 ] - cells[ 0 ] + 1 ) * ( cells[ 3 ] - cells[ 1 ] + 1 ) > SOLID_GRID_MAX_CELLS )
+		{
+			cells[ 0 ] = 1;
+			cells[ 2 ] = 0;
+			grid.unindexed.append( i );
+			continue;
+		}
+
+		for ( int x = cells[ 0 ]; x <= cells[ 2 ]; x++ )
+		{
+			for ( int y = cells[ 1 ]; y <= cells[ 3 ]; y++ )
+			{
+				grid.bucketStart[ CG_SolidGridBucket( x, y ) + 1 ]++;
+			}
+		}
+	}
+
+	for ( int b = 0; b < SOLID_GRID_BUCKETS; b++ )
+	{
+		grid.bucketStart[ b + 1 ] += grid.bucketStart[ b ];
+	}
+
+	// second pass: fill the buckets, in solid list order
+	grid.bucketItems.resize( grid.bucketStart[ SOLID_GRID_BUCKETS ] );
+
+	int fill[ SOLID_GRID_BUCKETS ];
+	memcpy( fill, grid.bucketStart, sizeof( fill ) );
+
+	for ( unsigned i = 0; i < cg_solidEntities.size(); i++ )
+	{
+		const int *cells = cellBounds[ i ];
+
+		for ( int x = cells[ 0 ]; x <= cells[ 2 ]; x++ )
+		{
+			for ( int y = cells[ 1 ]; y <= cells[ 3 ]; y++ )
+			{
+				grid.bucketItems[ fill[ CG_SolidGridBucket( x, y ) ]++ ] = i;
+			}
+		}
+	}
+}
+
+/*
+====================
+CG_SolidGridQuery
+
+Fills cg_solidGrid.candidates with the solid list indices of the entities
+a trace within the given bounds may hit, in solid list order.
+====================
+*/
+static void CG_SolidGridQuery( const vec3_t mins, const vec3_t maxs )
+{
+	solidGrid_t &grid = cg_solidGrid;
+
+	if ( grid.frame != cg.clientFrame )
+	{
+		CG_BuildSolidGrid();
+	}
+
+	grid.candidates.clear();
+
+	int x0 = CG_SolidGridCell( mins[ 0 ] );
+	int y0 = CG_SolidGridCell( mins[ 1 ] );
+	int x1 = CG_SolidGridCell( maxs[ 0 ] );
+	int y1 = CG_SolidGridCell( maxs[ 1 ] );
+
+	if ( ( x1 - x0 + 1 ) * ( y1 - y0 + 1 ) > SOLID_GRID_MAX_QUERY )
+	{
+		for ( unsigned i = 0; i < cg_solidEntities.size(); i++ )
+		{
+			grid.candidates.push_back( i );
+		}
+
+		return;
+	}
+
+	if ( ++grid.stamp <= 0 )
+	{
+		// wrapped around, so forget about old queries
+		memset( grid.queryStamp, 0, sizeof( grid.queryStamp ) );
+		grid.stamp = 1;
+	}
+
+	for ( int x = x0; x <= x1; x++ )
+	{
+		for ( int y = y0; y <= y1; y++ )
+		{
+			int b = CG_SolidGridBucket( x, y );
+
+			for ( int j = grid.bucketStart[ b ]; j < grid.bucketStart[ b + 1 ]; j++ )
+			{
+				int i = grid.bucketItems[ j ];
+
+				if ( grid.queryStamp[ i ] != grid.stamp )
+				{
+					grid.queryStamp[ i ] = grid.stamp;
+					grid.candidates.push_back( i );
+				}
+			}
+		}
+	}
+
+	for ( int i : grid.unindexed )
+	{
+		grid.candidates.push_back( i );
+	}
+
+	std::sort( grid.candidates.begin(), grid.candidates.end() );
+}
+
 /*
 ====================
 CG_BuildSolidList
@@ -52,6 +337,11 @@ void CG_BuildSolidList()
 	cg_solidEntities.clear();
 	cg_triggerEntities.clear();
 
+	for ( int &index : cg_solidListIndex )
+	{
+		index = -1;
+	}
+
 	snapshot_t *snap = (cg.nextSnap && !cg.nextFrameTeleport && !cg.thisFrameTeleport)
 		? cg.nextSnap
 		: cg.snap;
@@ -81,9 +371,169 @@ void CG_BuildSolidList()
 					break;
 			}
 
+			cg_solidListIndex[ ent->number ] = cg_solidEntities.size();
 			cg_solidEntities.append(cent);
 		}
 	}
+
+	// positions changed, rebuild the grid on the next trace
+	cg_solidGrid.frame = -1;
+}
+
+/*
+====================
+CG_HashSolidEntity
+
+Hashes the state of an entity that CG_ClipMoveToEntities depends on
+====================
+*/
+static uint32_t CG_HashSolidEntity( uint32_t hash, int entityNum )
+{
+	const centity_t     *cent = &cg_entities[ entityNum ];
+	const entityState_t *ent = &cent->currentState;
+	vec3_t              origin;
+	int                 solid = cg_solidListIndex[ entityNum ] >= 0;
+
+	hash = BG_HashBytes( hash, &entityNum, sizeof( entityNum ) );
+	hash = BG_HashBytes( hash, &solid, sizeof( solid ) );
+
+	if ( !solid )
+	{
+		return hash;
+	}
+
+	hash = BG_HashBytes( hash, &cent->contents, sizeof( cent->contents ) );
+	hash = BG_HashBytes( hash, &ent->solid, sizeof( ent->solid ) );
+	hash = BG_HashBytes( hash, &ent->modelindex, sizeof( ent->modelindex ) );
+	hash = BG_HashBytes( hash, &ent->eType, sizeof( ent->eType ) );
+
+	if ( ent->solid == SOLID_BMODEL )
+	{
+		BG_EvaluateTrajectory( &ent->pos, cg.physicsTime, origin );
+		hash = BG_HashBytes( hash, origin, sizeof( vec3_t ) );
+		hash = BG_HashBytes( hash, cent->lerpAngles, sizeof( vec3_t ) );
+
+		// where CG_PointContents places it
+		hash = BG_HashBytes( hash, ent->origin, sizeof( vec3_t ) );
+		hash = BG_HashBytes( hash, ent->angles, sizeof( vec3_t ) );
+	}
+	else
+	{
+		hash = BG_HashBytes( hash, cent->lerpOrigin, sizeof( vec3_t ) );
+	}
+
+	return hash;
+}
+
+/*
+====================
+CG_HashTouchedEntities
+====================
+*/
+static uint32_t CG_HashTouchedEntities( const predictionInputs_t *inputs )
+{
+	uint32_t hash = BG_HASH_INIT;
+
+	for ( int i = 0; i < inputs->numTouched; i++ )
+	{
+		hash = CG_HashSolidEntity( hash, inputs->touched[ i ] );
+	}
+
+	return hash;
+}
+
+/*
+====================
+CG_RecordTouchedEntity
+====================
+*/
+static void CG_RecordTouchedEntity( int entityNum )
+{
+	predictionInputs_t *inputs = cg_predictionRecord;
+
+	if ( inputs->numTouched < 0 )
+	{
+		return;
+	}
+
+	for ( int i = 0; i < inputs->numTouched; i++ )
+	{
+		if ( inputs->touched[ i ] == entityNum )
+		{
+			return;
+		}
+	}
+
+	if ( inputs->numTouched == MAX_PREDICTION_TOUCHES )
+	{
+		inputs->numTouched = -1;
+		cg_predictionTouchOverflows++;
+		return;
+	}
+
+	inputs->touched[ inputs->numTouched++ ] = entityNum;
+}
+
+/*
+====================
+CG_BModelBounds
+
+World bounds of a bmodel placed at origin and angles, with a unit of room
+for the collision epsilon
+====================
+*/
+static void CG_BModelBounds( clipHandle_t cmodel, const vec3_t origin, const vec3_t angles,
+                             vec3_t mins, vec3_t maxs )
+{
+	CM_ModelBounds( cmodel, mins, maxs );
+
+	// a rotated bmodel stays within the sphere around its origin
+	if ( angles[ 0 ] || angles[ 1 ] || angles[ 2 ] )
+	{
+		float radius = RadiusFromBounds( mins, maxs );
+
+		VectorSet( mins, -radius, -radius, -radius );
+		VectorSet( maxs, radius, radius, radius );
+	}
+
+	for ( int i = 0; i < 3; i++ )
+	{
+		mins[ i ] += origin[ i ] - 1.0f;
+		maxs[ i ] += origin[ i ] + 1.0f;
+	}
+}
+
+/*
+====================
+CG_HashUsercmd
+
+Hashes a command field by field, leaving out the struct padding
+====================
+*/
+static uint32_t CG_HashUsercmd( uint32_t hash, const usercmd_t *cmd )
+{
+	hash = BG_HashBytes( hash, &cmd->serverTime, sizeof( cmd->serverTime ) );
+	hash = BG_HashBytes( hash, cmd->angles, sizeof( cmd->angles ) );
+	hash = BG_HashBytes( hash, &cmd->forwardmove, sizeof( cmd->forwardmove ) );
+	hash = BG_HashBytes( hash, &cmd->rightmove, sizeof( cmd->rightmove ) );
+	hash = BG_HashBytes( hash, &cmd->upmove, sizeof( cmd->upmove ) );
+	hash = BG_HashBytes( hash, &cmd->doubleTap, sizeof( cmd->doubleTap ) );
+	hash = BG_HashBytes( hash, &cmd->weapon, sizeof( cmd->weapon ) );
+	hash = BG_HashBytes( hash, &cmd->flags, sizeof( cmd->flags ) );
+	hash = BG_HashBytes( hash, cmd->buttons, sizeof( cmd->buttons ) );
+
+	return hash;
+}
+
+/*
+====================
+CG_PredictionInputsMatch
+====================
+*/
+static bool CG_PredictionInputsMatch( const predictionInputs_t *inputs, uint32_t cmdHash )
+{
+	return inputs->cmdHash == cmdHash && inputs->numTouched >= 0 &&
+	       inputs->touchHash == CG_HashTouchedEntities( inputs );
 }
 
 /*
@@ -96,12 +546,12 @@ static void CG_ClipMoveToEntities( const vec3_t start, const vec3_t mins,
                                    const vec3_t maxs, const vec3_t end, int skipNumber,
                                    int mask, int skipmask, trace_t *tr, traceType_t collisionType )
 {
-	int           x, zd, zu;
 	trace_t       trace;
 	clipHandle_t  cmodel;
 	vec3_t        tmins, tmaxs;
 	vec3_t        bmins, bmaxs;
 	vec3_t        origin, angles;
+	bool          useGrid;
 
 	// calculate bounding box of the trace
 	ClearBounds( tmins, tmaxs );
@@ -112,8 +562,18 @@ static void CG_ClipMoveToEntities( const vec3_t start, const vec3_t mins,
 	if( maxs )
 		VectorAdd( maxs, tmaxs, tmaxs );
 
-	for ( centity_t *cent : cg_solidEntities )
+	useGrid = cg_solidEntityGrid.Get() && !cg_solidGridDisabled;
+
+	if ( useGrid )
+	{
+		CG_SolidGridQuery( tmins, tmaxs );
+	}
+
+	unsigned numCandidates = useGrid ? cg_solidGrid.candidates.size() : cg_solidEntities.size();
+
+	for ( unsigned c = 0; c < numCandidates; c++ )
 	{
+		centity_t     *cent = useGrid ? cg_solidEntities[ cg_solidGrid.candidates[ c ] ] : cg_solidEntities[ c ];
 		entityState_t *ent = &cent->currentState;
 
 		if ( ent->number == skipNumber )
@@ -137,24 +597,22 @@ static void CG_ClipMoveToEntities( const vec3_t start, const vec3_t mins,
 			cmodel = CM_InlineModel( ent->modelindex );
 			VectorCopy( cent->lerpAngles, angles );
 			BG_EvaluateTrajectory( &cent->currentState.pos, cg.physicsTime, origin );
+
+			CG_BModelBounds( cmodel, origin, angles, bmins, bmaxs );
+
+			if( !BoundsIntersect( bmins, bmaxs, tmins, tmaxs ) )
+				continue;
 		}
 		else
 		{
-			if ( ent->eType == entityType_t::ET_BUILDABLE )
+			if ( useGrid )
 			{
-				BG_BuildableBoundingBox( ent->modelindex, bmins, bmaxs );
+				VectorCopy( cg_solidGrid.boxMins[ cg_solidGrid.candidates[ c ] ], bmins );
+				VectorCopy( cg_solidGrid.boxMaxs[ cg_solidGrid.candidates[ c ] ], bmaxs );
 			}
 			else
 			{
-				// encoded bbox
-				x = ( ent->solid & 255 );
-				zd = ( ( ent->solid >> 8 ) & 255 );
-				zu = ( ( ent->solid >> 16 ) & 255 ) - 32;
-
-				bmins[ 0 ] = bmins[ 1 ] = -x;
-				bmaxs[ 0 ] = bmaxs[ 1 ] = x;
-				bmins[ 2 ] = -zd;
-				bmaxs[ 2 ] = zu;
+				CG_SolidEntityBox( ent, bmins, bmaxs );
 			}
 
 			VectorAdd( cent->lerpOrigin, bmins, bmins );
@@ -168,6 +626,11 @@ static void CG_ClipMoveToEntities( const vec3_t start, const vec3_t mins,
 			VectorCopy( vec3_origin, origin );
 		}
 
+		if ( cg_predictionRecord )
+		{
+			CG_RecordTouchedEntity( ent->number );
+		}
+
 		switch ( collisionType )
 		{
 		case traceType_t::TT_CAPSULE:
@@ -302,8 +765,15 @@ int   CG_PointContents( const vec3_t point, int passEntityNum )
 
 	contents = CM_PointContents( point, 0 );
 
-	for ( centity_t *cent : cg_solidEntities )
+	// only bmodels contribute contents, the grid keeps a list of them
+	if ( cg_solidGrid.frame != cg.clientFrame )
 	{
+		CG_BuildSolidGrid();
+	}
+
+	for ( int i : cg_solidGrid.bmodels )
+	{
+		centity_t     *cent = cg_solidEntities[ i ];
 		entityState_t *ent = &cent->currentState;
 
 		if ( ent->number == passEntityNum )
@@ -311,11 +781,6 @@ int   CG_PointContents( const vec3_t point, int passEntityNum )
 			continue;
 		}
 
-		if ( ent->solid != SOLID_BMODEL ) // special value for bmodel
-		{
-			continue;
-		}
-
 		cmodel = CM_InlineModel( ent->modelindex );
 
 		if ( !cmodel )
@@ -323,6 +788,18 @@ int   CG_PointContents( const vec3_t point, int passEntityNum )
 			continue;
 		}
 
+		if ( cg_predictionRecord )
+		{
+			vec3_t bmins, bmaxs;
+
+			CG_BModelBounds( cmodel, ent->origin, ent->angles, bmins, bmaxs );
+
+			if ( BoundsIntersect( bmins, bmaxs, point, point ) )
+			{
+				CG_RecordTouchedEntity( ent->number );
+			}
+		}
+
 		contents |= CM_TransformedPointContents( point, cmodel, ent->origin, ent->angles );
 	}
 
@@ -634,6 +1111,7 @@ void CG_PredictPlayerState()
 	usercmd_t     oldestCmd;
 	usercmd_t     latestCmd;
 	int           stateIndex = 0, predictCmd = 0;
+	int           reusedCommands = 0, replayedCommands = 0;
 
 	cg.hyperspace = false; // will be set if touching a trigger_teleport
 
@@ -746,6 +1224,10 @@ void CG_PredictPlayerState()
 	// except a frame following a new snapshot in which there was a prediction
 	// error.  This yields anywhere from a 15% to 40% performance increase,
 	// depending on how much of a bottleneck the CPU is.
+	//
+	// Each saved state also remembers a hash of its usercmd and of the solid
+	// entities its traces and content checks touched. A saved state is only reused while those
+	// are unchanged; otherwise prediction restarts from that command.
 	if ( cg_optimizePrediction.Get() )
 	{
 		if ( cg.nextFrameTeleport || cg.thisFrameTeleport )
@@ -939,28 +1421,62 @@ void CG_PredictPlayerState()
 		{
 			Pmove( &cg_pmove );
 		}
-		else if ( cg_optimizePrediction.Get() && ( cmdNum >= predictCmd ||
-		          ( stateIndex + 1 ) % NUM_SAVED_STATES == cg.stateHead ) )
+		else
 		{
-			Pmove( &cg_pmove );
-			// record the last predicted command
-			cg.lastPredictedCommand = cmdNum;
+			bool     queueFull = ( stateIndex + 1 ) % NUM_SAVED_STATES == cg.stateHead;
+			uint32_t cmdHash = CG_HashUsercmd( BG_HASH_INIT, &cg_pmove.cmd );
+
+			cmdHash = BG_HashBytes( cmdHash, &cg_pmove.tracemask, sizeof( cg_pmove.tracemask ) );
+
+			// a saved state can only be reused while the command and the
+			// entities it collided with are unchanged, otherwise restart the
+			// prediction from this command
+			if ( cmdNum < predictCmd && !queueFull &&
+			     !CG_PredictionInputsMatch( &cg.savedPmoveInputs[ stateIndex ], cmdHash ) )
+			{
+				if ( cg_showmiss.Get() )
+				{
+					Log::Debug( "prediction inputs changed at command %d", cmdNum );
+				}
+
+				predictCmd = cmdNum;
+			}
 
-			// if we haven't run out of space in the saved states queue
-			if ( ( stateIndex + 1 ) % NUM_SAVED_STATES != cg.stateHead )
+			if ( cmdNum >= predictCmd || queueFull )
 			{
-				// save the state for the false case ( of cmdNum >= predictCmd )
-				// in later calls to this function
-				cg.savedPmoveStates[ stateIndex ] = *cg_pmove.ps;
+				predictionInputs_t inputs;
+
+				inputs.cmdHash = cmdHash;
+				inputs.numTouched = 0;
+
+				cg_predictionRecord = &inputs;
+				Pmove( &cg_pmove );
+				cg_predictionRecord = nullptr;
+
+				inputs.touchHash = CG_HashTouchedEntities( &inputs );
+				replayedCommands++;
+
+				// record the last predicted command
+				cg.lastPredictedCommand = cmdNum;
+
+				// if we haven't run out of space in the saved states queue
+				if ( !queueFull )
+				{
+					// save the state for the false case ( of cmdNum >= predictCmd )
+					// in later calls to this function
+					cg.savedPmoveStates[ stateIndex ] = *cg_pmove.ps;
+					cg.savedPmoveInputs[ stateIndex ] = inputs;
+					stateIndex = ( stateIndex + 1 ) % NUM_SAVED_STATES;
+					cg.stateTail = stateIndex;
+				}
+			}
+			else
+			{
+				*cg_pmove.ps = cg.savedPmoveStates[ stateIndex ];
 				stateIndex = ( stateIndex + 1 ) % NUM_SAVED_STATES;
-				cg.stateTail = stateIndex;
+				reusedCommands++;
 			}
 		}
-		else
-		{
-			*cg_pmove.ps = cg.savedPmoveStates[ stateIndex ];
-			stateIndex = ( stateIndex + 1 ) % NUM_SAVED_STATES;
-		}
 
 		// add push trigger movement effects
 		CG_TouchTriggerPrediction();
@@ -969,6 +1485,12 @@ void CG_PredictPlayerState()
 		//CG_CheckChangedPredictableEvents(&cg.predictedPlayerState);
 	}
 
+	if ( cg_showmiss.Get() && cg_optimizePrediction.Get() )
+	{
+		Log::Debug( "prediction: %d commands reused, %d replayed, %d touch overflows so far",
+		            reusedCommands, replayedCommands, cg_predictionTouchOverflows );
+	}
+
 	// adjust for the movement of the groundentity
 	CG_AdjustPositionForMover( cg.predictedPlayerState.origin,
 	                           cg.predictedPlayerState.groundEntityNum,
@@ -977,3 +1499,87 @@ void CG_PredictPlayerState()
 	// fire events and other transition triggered things
 	CG_TransitionPlayerState( &cg.predictedPlayerState, &oldPlayerState );
 }
+
+/*
+=================
+CG_PredictionBenchmark_f
+
+Replays the unacknowledged commands on top of the latest snapshot's
+playerState a number of times, with and without the solid entity grid,
+and reports the time spent. The predicted state is left untouched.
+=================
+*/
+void CG_PredictionBenchmark_f()
+{
+	int           iterations = 100;
+	int           current;
+	usercmd_t     latestCmd;
+	playerState_t savedPlayerState;
+	pmoveExt_t    savedPmext;
+	snapshot_t    *snap;
+
+	if ( trap_Argc() > 1 )
+	{
+		iterations = std::max( 1, atoi( CG_Argv( 1 ) ) );
+	}
+
+	if ( !cg.snap || !cg_pmove.trace )
+	{
+		Log::Notice( "predictionBenchmark: no prediction has been run yet" );
+		return;
+	}
+
+	snap = ( cg.nextSnap && !cg.nextFrameTeleport && !cg.thisFrameTeleport )
+		? cg.nextSnap
+		: cg.snap;
+
+	savedPlayerState = cg.predictedPlayerState;
+	savedPmext = cg.pmext;
+
+	current = trap_GetCurrentCmdNumber();
+	trap_GetUserCmd( current, &latestCmd );
+
+	for ( int pass = 0; pass < 2; pass++ )
+	{
+		int commands = 0;
+		int startTime;
+
+		cg_solidGridDisabled = ( pass == 0 );
+		startTime = trap_Milliseconds();
+
+		for ( int i = 0; i < iterations; i++ )
+		{
+			cg.predictedPlayerState = snap->ps;
+			cg.pmext = savedPmext;
+
+			for ( int cmdNum = current - CMD_BACKUP + 1; cmdNum <= current; cmdNum++ )
+			{
+				trap_GetUserCmd( cmdNum, &cg_pmove.cmd );
+
+				if ( cg_pmove.cmd.serverTime <= cg.predictedPlayerState.commandTime ||
+				     cg_pmove.cmd.serverTime > latestCmd.serverTime )
+				{
+					continue;
+				}
+
+				if ( cg_pmove.pmove_fixed )
+				{
+					PM_UpdateViewAngles( cg_pmove.ps, &cg_pmove.cmd );
+					cg_pmove.cmd.serverTime = ( ( cg_pmove.cmd.serverTime + cg.pmoveParams.msec - 1 ) /
+					                            cg.pmoveParams.msec ) * cg.pmoveParams.msec;
+				}
+
+				Pmove( &cg_pmove );
+				commands++;
+			}
+		}
+
+		Log::Notice( "%s: %d commands against %d solid entities in %d msec",
+		             pass == 0 ? "linear scan" : "solid grid", commands,
+		             (int) cg_solidEntities.size(), trap_Milliseconds() - startTime );
+	}
+
+	cg_solidGridDisabled = false;
+	cg.predictedPlayerState = savedPlayerState;
+	cg.pmext = savedPmext;
+}
@@ -54,6 +54,7 @@ void CG_Rocket_Init( glconfig_t gl )
 	Trans_Init();
 
 	BG_LoadEmoticons();
+	Rocket_ClearQuakeToRMLCache();
 
 	// Init Rocket
 	Rocket_Init();
@@ -553,6 +554,7 @@ void CG_Rocket_Frame( cgClientState_t state )
 	}
 
 	CG_Rocket_ProcessEvents();
+	Rocket_DSCommitTables();
 	Rocket_Update();
 	Rocket_Render();
 	if ( rocketInfo.renderCursor && rocketInfo.cursor )
@@ -34,34 +34,201 @@ Maryland 20850 USA.
 
 #include "cg_local.h"
 
-static void AddToServerList( const char *name, const char *label, int clients, int bots, int ping, int maxClients, char *mapName, char *addr, int netSrc )
+/*
+ * Every server list keeps an index per sort order, which servers are
+ * inserted into as their ping replies arrive. Sorting and filtering then
+ * only walk an index, comparing keys that were lowercased and stripped
+ * of colours once instead of for every comparison.
+ */
+
+static char *ServerSortKey( const char *text )
+{
+	char key[ MAX_STRING_CHARS ];
+
+	Q_strncpyz( key, text, sizeof( key ) );
+	Color::StripColors( key );
+	Q_strlwr( key );
+
+	return BG_strdup( key );
+}
+
+static int ServerListCmp( int sort, const server_t *a, const server_t *b )
+{
+	switch ( sort )
+	{
+		case SERVER_SORT_PING:
+			return a->ping - b->ping;
+
+		case SERVER_SORT_NAME:
+			return strcmp( a->sortName, b->sortName );
+
+		case SERVER_SORT_MAP:
+			return strcmp( a->sortMap, b->sortMap );
+
+		case SERVER_SORT_PLAYERS:
+			return a->clients - b->clients;
+
+		default:
+			return 0;
+	}
+}
+
+// count is the number of servers already in the index
+static void InsertServerOrder( int netSrc, int sort, int slot, int count )
+{
+	int *order = rocketInfo.data.serverOrder[ netSrc ][ sort ];
+	const server_t *servers = rocketInfo.data.servers[ netSrc ];
+	int low = 0, high = count;
+
+	// insert after any equal servers
+	while ( low < high )
+	{
+		int mid = ( low + high ) / 2;
+
+		if ( ServerListCmp( sort, &servers[ order[ mid ] ], &servers[ slot ] ) <= 0 )
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid;
+		}
+	}
+
+	memmove( order + low + 1, order + low, ( count - low ) * sizeof( int ) );
+	order[ low ] = slot;
+}
+
+static void RemoveServerOrder( int netSrc, int sort, int slot, int count )
+{
+	int *order = rocketInfo.data.serverOrder[ netSrc ][ sort ];
+	int *found = std::find( order, order + count, slot );
+
+	if ( found != order + count )
+	{
+		memmove( found, found + 1, ( order + count - found - 1 ) * sizeof( int ) );
+	}
+}
+
+static void ReadServerInfo( server_t *node, const char *info, int ping )
+{
+	node->name = BG_strdup( Info_ValueForKey( info, "hostname" ) );
+	node->label = BG_strdup( Info_ValueForKey( info, "label" ) );
+	node->addr = BG_strdup( Info_ValueForKey( info, "addr" ) );
+	node->mapName = BG_strdup( Info_ValueForKey( info, "mapname" ) );
+	node->sortName = ServerSortKey( node->name );
+	node->sortMap = ServerSortKey( node->mapName );
+	node->info = BG_strdup( info );
+	node->clients = atoi( Info_ValueForKey( info, "clients" ) );
+	node->bots = atoi( Info_ValueForKey( info, "bots" ) );
+	node->maxClients = atoi( Info_ValueForKey( info, "sv_maxclients" ) );
+	node->ping = ping;
+}
+
+static void FreeServerInfo( server_t *node )
+{
+	BG_Free( node->name );
+	BG_Free( node->label );
+	BG_Free( node->addr );
+	BG_Free( node->mapName );
+	BG_Free( node->sortName );
+	BG_Free( node->sortMap );
+	BG_Free( node->info );
+}
+
+static void AddToServerList( const char *info, int ping, int lanIndex, int netSrc )
 {
 	server_t *node;
+	int slot = rocketInfo.data.serverCount[ netSrc ];
 
-	if ( rocketInfo.data.serverCount[ netSrc ] == MAX_SERVERS )
+	if ( slot == MAX_SERVERS )
 	{
 		return;
 	}
 
-	if ( !*name || !*mapName )
+	if ( !*Info_ValueForKey( info, "hostname" ) || !*Info_ValueForKey( info, "mapname" ) )
 	{
 		return;
 	}
 
-	node = &rocketInfo.data.servers[ netSrc ][ rocketInfo.data.serverCount[ netSrc ] ];
+	node = &rocketInfo.data.servers[ netSrc ][ slot ];
+	node->lanIndex = lanIndex;
+	ReadServerInfo( node, info, ping );
 
-	node->name = BG_strdup( name );
-	node->clients = clients;
-	node->bots = bots;
-	node->ping = ping;
-	node->maxClients = maxClients;
-	node->addr = BG_strdup( addr );
-	node->label = BG_strdup( label );
-	node->mapName = BG_strdup( mapName );
+	rocketInfo.data.serverOrder[ netSrc ][ SERVER_SORT_ARRIVAL ][ slot ] = slot;
+
+	for ( int sort = SERVER_SORT_ARRIVAL + 1; sort < SERVER_SORT_NUM; sort++ )
+	{
+		InsertServerOrder( netSrc, sort, slot, slot );
+	}
 
+	rocketInfo.data.serverLanSlots[ netSrc ][ lanIndex ] = slot;
 	rocketInfo.data.serverCount[ netSrc ]++;
 }
 
+// A server answered with something new, read it again and move it to
+// where it now sorts
+static void UpdateServerInList( const char *info, int ping, int slot, int netSrc )
+{
+	server_t *node = &rocketInfo.data.servers[ netSrc ][ slot ];
+	int count = rocketInfo.data.serverCount[ netSrc ];
+
+	if ( !*Info_ValueForKey( info, "hostname" ) || !*Info_ValueForKey( info, "mapname" ) )
+	{
+		return;
+	}
+
+	for ( int sort = SERVER_SORT_ARRIVAL + 1; sort < SERVER_SORT_NUM; sort++ )
+	{
+		RemoveServerOrder( netSrc, sort, slot, count );
+	}
+
+	FreeServerInfo( node );
+	ReadServerInfo( node, info, ping );
+
+	for ( int sort = SERVER_SORT_ARRIVAL + 1; sort < SERVER_SORT_NUM; sort++ )
+	{
+		InsertServerOrder( netSrc, sort, slot, count - 1 );
+	}
+}
+
+// Show the servers in the current order which pass the current filter
+static void EmitServerList( int netSrc, const char *table )
+{
+	const server_t *servers = rocketInfo.data.servers[ netSrc ];
+	const int *order = rocketInfo.data.serverOrder[ netSrc ][ rocketInfo.data.serverSort[ netSrc ] ];
+	const char *filter = rocketInfo.data.serverFilter[ netSrc ];
+	char data[ MAX_INFO_STRING ];
+	int rows = 0;
+
+	Rocket_DSBeginTable( "server_browser", table );
+
+	for ( int i = 0; i < rocketInfo.data.serverCount[ netSrc ]; ++i )
+	{
+		const server_t *server = &servers[ order[ i ] ];
+
+		if ( *filter && !strstr( server->sortName, filter ) && !strstr( server->sortMap, filter ) )
+		{
+			continue;
+		}
+
+		data[ 0 ] = '\0';
+		Info_SetValueForKey( data, "name", server->name, false );
+		Info_SetValueForKey( data, "players", va( "%d", server->clients ), false );
+		Info_SetValueForKey( data, "bots", va( "%d", server->bots ), false );
+		Info_SetValueForKey( data, "ping", va( "%d", server->ping ), false );
+		Info_SetValueForKey( data, "maxClients", va( "%d", server->maxClients ), false );
+		Info_SetValueForKey( data, "addr", server->addr, false );
+		Info_SetValueForKey( data, "label", server->label, false );
+		Info_SetValueForKey( data, "map", server->mapName, false );
+
+		Rocket_DSAddRow( "server_browser", table, data );
+		rocketInfo.data.serverRows[ netSrc ][ rows++ ] = order[ i ];
+	}
+
+	rocketInfo.data.serverRowCount[ netSrc ] = rows;
+}
+
 static void CG_Rocket_SetServerListServer( const char *table, int index )
 {
 	int netSrc = CG_StringToNetSource( table );
@@ -71,7 +238,15 @@ static void CG_Rocket_SetServerListServer( const char *table, int index )
 		return;
 	}
 
-	rocketInfo.data.serverIndex[ netSrc ] = index;
+	if ( index >= 0 && index < rocketInfo.data.serverRowCount[ netSrc ] )
+	{
+		rocketInfo.data.serverIndex[ netSrc ] = rocketInfo.data.serverRows[ netSrc ][ index ];
+	}
+	else
+	{
+		rocketInfo.data.serverIndex[ netSrc ] = -1;
+	}
+
 	rocketInfo.currentNetSrc = netSrc;
 	CG_Rocket_BuildServerInfo();
 }
@@ -115,8 +290,8 @@ void CG_Rocket_BuildServerInfo()
 		static char key[BIG_INFO_VALUE], value[ BIG_INFO_VALUE ];
 		char name[ MAX_STRING_CHARS ];
 
-		Rocket_DSClearTable( "server_browser", "serverInfo" );
-		Rocket_DSClearTable( "server_browser", "serverPlayers" );
+		Rocket_DSBeginTable( "server_browser", "serverInfo" );
+		Rocket_DSBeginTable( "server_browser", "serverPlayers" );
 
 		p = serverInfoText;
 
@@ -231,8 +406,8 @@ void CG_Rocket_BuildServerInfo()
 
 void CG_Rocket_BuildServerList( const char *args )
 {
-	char data[ MAX_INFO_STRING ] = { 0 };
 	int netSrc = CG_StringToNetSource( args );
+	std::vector<int> &lanSlots = rocketInfo.data.serverLanSlots[ netSrc ];
 	int i;
 
 	// Only refresh once every second
@@ -248,9 +423,6 @@ void CG_Rocket_BuildServerList( const char *args )
 
 	rocketInfo.data.retrievingServers = true;
 
-	Rocket_DSClearTable( "server_browser", args );
-	CG_Rocket_CleanUpServerList( args );
-
 	trap_LAN_MarkServerVisible( netSrc, -1, true );
 
 	numServers = trap_LAN_GetServerCount( netSrc );
@@ -258,15 +430,21 @@ void CG_Rocket_BuildServerList( const char *args )
 	// Still waiting for a response...
 	if ( numServers == -1 )
 	{
+		EmitServerList( netSrc, args );
 		return;
 	}
 
+	if ( ( int ) lanSlots.size() < numServers )
+	{
+		lanSlots.resize( numServers, -1 );
+	}
+
+	// Only servers which have not been seen yet or whose info or ping
+	// changed need their place in the indexes found
 	for ( i = 0; i < numServers; ++i )
 	{
 		char info[ MAX_STRING_CHARS ];
-		int ping, bots, clients, maxClients;
-
-		memset( &data, 0, sizeof( data ) );
+		int ping, slot;
 
 		if ( !trap_LAN_ServerIsVisible( netSrc, i ) )
 		{
@@ -274,142 +452,60 @@ void CG_Rocket_BuildServerList( const char *args )
 		}
 
 		ping = trap_LAN_GetServerPing( netSrc, i );
+		slot = lanSlots[ i ];
 
-		if ( ping >= 0 )
-		{
-			char addr[ 50 ]; // long enough for IPv6 literal plus port no.
-			char mapname[ 256 ];
-			trap_LAN_GetServerInfo( netSrc, i, info, sizeof( info ) );
-
-			bots = atoi( Info_ValueForKey( info, "bots" ) );
-			clients = atoi( Info_ValueForKey( info, "clients" ) );
-			maxClients = atoi( Info_ValueForKey( info, "sv_maxclients" ) );
-			Q_strncpyz( addr, Info_ValueForKey( info, "addr" ), sizeof( addr ) );
-			Q_strncpyz( mapname, Info_ValueForKey( info, "mapname" ), sizeof( mapname ) );
-			AddToServerList( Info_ValueForKey( info, "hostname" ), Info_ValueForKey( info, "label" ), clients, bots, ping, maxClients, mapname, addr, netSrc );
-		}
-	}
-
-	for ( i = 0; i < rocketInfo.data.serverCount[ netSrc ]; ++i )
-	{
-		if ( rocketInfo.data.servers[ netSrc ][ i ].ping <= 0 )
+		if ( ping <= 0 )
 		{
 			continue;
 		}
 
-		Info_SetValueForKey( data, "name", rocketInfo.data.servers[ netSrc ][ i ].name, false );
-		Info_SetValueForKey( data, "players", va( "%d", rocketInfo.data.servers[ netSrc ][ i ].clients ), false );
-		Info_SetValueForKey( data, "bots", va( "%d", rocketInfo.data.servers[ netSrc ][ i ].bots ), false );
-		Info_SetValueForKey( data, "ping", va( "%d", rocketInfo.data.servers[ netSrc ][ i ].ping ), false );
-		Info_SetValueForKey( data, "maxClients", va( "%d", rocketInfo.data.servers[ netSrc ][ i ].maxClients ), false );
-		Info_SetValueForKey( data, "addr", rocketInfo.data.servers[ netSrc ][ i ].addr, false );
-		Info_SetValueForKey( data, "label", rocketInfo.data.servers[ netSrc ][ i ].label, false );
-		Info_SetValueForKey( data, "map", rocketInfo.data.servers[ netSrc ][ i ].mapName, false );
+		trap_LAN_GetServerInfo( netSrc, i, info, sizeof( info ) );
 
-		Rocket_DSAddRow( "server_browser", args, data );
+		if ( slot >= 0 )
+		{
+			const server_t *server = &rocketInfo.data.servers[ netSrc ][ slot ];
 
-		if ( rocketInfo.data.retrievingServers )
+			if ( server->ping != ping || strcmp( server->info, info ) )
+			{
+				UpdateServerInList( info, ping, slot, netSrc );
+			}
+		}
+		else
 		{
-			rocketInfo.data.retrievingServers = false;
+			AddToServerList( info, ping, i, netSrc );
 		}
 	}
-}
-
-static int ServerListCmpByPing( const void *one, const void *two )
-{
-	server_t* a = ( server_t* ) one;
-	server_t* b = ( server_t* ) two;
-
-	if ( a->ping > b->ping ) return 1;
-
-	if ( b->ping > a->ping ) return -1;
-
-	if ( a->ping == b->ping )  return 0;
-
-	return 0; // silence compiler
-}
-
-static int ServerListCmpByName( const void* one, const void* two )
-{
-	static char cleanName1[ MAX_STRING_CHARS ] = { 0 };
-	static char cleanName2[ MAX_STRING_CHARS ] = { 0 };
-	server_t* a = ( server_t* ) one;
-	server_t* b = ( server_t* ) two;
-
-	Q_strncpyz( cleanName1, a->name, sizeof( cleanName1 ) );
-	Q_strncpyz( cleanName2, b->name, sizeof( cleanName2 ) );
-
-	Color::StripColors( cleanName1 );
-	Color::StripColors( cleanName2 );
 
-	return Q_stricmp( cleanName1, cleanName2 );
-}
-
-static int ServerListCmpByMap( const void* one, const void* two )
-{
-	server_t* a = ( server_t* ) one;
-	server_t* b = ( server_t* ) two;
-
-	return Q_stricmp( a->mapName, b->mapName );
-}
-
-static int ServerListCmpByPlayers( const void* one, const void* two )
-{
-	server_t* a = ( server_t* ) one;
-	server_t* b = ( server_t* ) two;
-
-	if ( a->clients > b->clients ) return 1;
-
-	if ( b->clients > a->clients ) return -1;
+	EmitServerList( netSrc, args );
 
-	if ( a->clients == b->clients )  return 0;
-
-	return 0; // silence compiler
+	if ( rocketInfo.data.serverRowCount[ netSrc ] )
+	{
+		rocketInfo.data.retrievingServers = false;
+	}
 }
 
 static void CG_Rocket_SortServerList( const char *name, const char *sortBy )
 {
-	char data[ MAX_INFO_STRING ] = { 0 };
 	int netSrc = CG_StringToNetSource( name );
-	int  i;
 
 	if ( !Q_stricmp( sortBy, "ping" ) )
 	{
-		qsort( rocketInfo.data.servers[ netSrc ], rocketInfo.data.serverCount[ netSrc ], sizeof( server_t ), &ServerListCmpByPing );
+		rocketInfo.data.serverSort[ netSrc ] = SERVER_SORT_PING;
 	}
 	else if ( !Q_stricmp( sortBy, "name" ) )
 	{
-		qsort( rocketInfo.data.servers[ netSrc ], rocketInfo.data.serverCount[ netSrc ], sizeof( server_t ), &ServerListCmpByName );
+		rocketInfo.data.serverSort[ netSrc ] = SERVER_SORT_NAME;
 	}
 	else if ( !Q_stricmp( sortBy, "players" ) )
 	{
-		qsort( rocketInfo.data.servers[ netSrc ], rocketInfo.data.serverCount[ netSrc ], sizeof( server_t ), &ServerListCmpByPlayers );
+		rocketInfo.data.serverSort[ netSrc ] = SERVER_SORT_PLAYERS;
 	}
 	else if ( !Q_stricmp( sortBy, "map" ) )
 	{
-		qsort( rocketInfo.data.servers[ netSrc ], rocketInfo.data.serverCount[ netSrc ], sizeof( server_t ), &ServerListCmpByMap );
+		rocketInfo.data.serverSort[ netSrc ] = SERVER_SORT_MAP;
 	}
 
-	Rocket_DSClearTable( "server_browser", name );
-
-	for ( i = 0; i < rocketInfo.data.serverCount[ netSrc ]; ++i )
-	{
-		if ( rocketInfo.data.servers[ netSrc ][ i ].ping <= 0 )
-		{
-			continue;
-		}
-
-		Info_SetValueForKey( data, "name", rocketInfo.data.servers[ netSrc ][ i ].name, false );
-		Info_SetValueForKey( data, "players", va( "%d", rocketInfo.data.servers[ netSrc ][ i ].clients ), false );
-		Info_SetValueForKey( data, "bots", va( "%d", rocketInfo.data.servers[ netSrc ][ i ].bots ), false );
-		Info_SetValueForKey( data, "ping", va( "%d", rocketInfo.data.servers[ netSrc ][ i ].ping ), false );
-		Info_SetValueForKey( data, "maxClients", va( "%d", rocketInfo.data.servers[ netSrc ][ i ].maxClients ), false );
-		Info_SetValueForKey( data, "addr", rocketInfo.data.servers[ netSrc ][ i ].addr, false );
-		Info_SetValueForKey( data, "label", rocketInfo.data.servers[ netSrc ][ i ].label, false );
-		Info_SetValueForKey( data, "map", rocketInfo.data.servers[ netSrc ][ i ].mapName, false );
-
-		Rocket_DSAddRow( "server_browser", name, data );
-	}
+	EmitServerList( netSrc, name );
 }
 
 void CG_Rocket_CleanUpServerList( const char *table )
@@ -424,12 +520,12 @@ void CG_Rocket_CleanUpServerList( const char *table )
 		{
 			for ( j = 0; j < rocketInfo.data.serverCount[ i ]; ++j )
 			{
-				BG_Free( rocketInfo.data.servers[ i ][ j ].name );
-				BG_Free( rocketInfo.data.servers[ i ][ j ].label );
-				BG_Free( rocketInfo.data.servers[ i ][ j ].addr );
-				BG_Free( rocketInfo.data.servers[ i ][ j ].mapName );
+				FreeServerInfo( &rocketInfo.data.servers[ i ][ j ] );
 			}
 			rocketInfo.data.serverCount[ i ] = 0;
+			rocketInfo.data.serverRowCount[ i ] = 0;
+			rocketInfo.data.serverIndex[ i ] = -1;
+			rocketInfo.data.serverLanSlots[ i ].clear();
 		}
 	}
 }
@@ -438,37 +534,24 @@ static void CG_Rocket_FilterServerList( const char *table, const char *filter )
 {
 	const char *str = ( table && *table ) ? table : CG_NetSourceToString( rocketInfo.currentNetSrc );
 	int netSrc = CG_StringToNetSource( str );
-	int i;
-
-	Rocket_DSClearTable( "server_browser", str );
-
-	for ( i = 0; i < rocketInfo.data.serverCount[ netSrc ]; ++i )
-	{
-		char name[ MAX_INFO_VALUE ];
-
-		Q_strncpyz( name, rocketInfo.data.servers[ netSrc ][ i ].name, sizeof( name ) );
-
-		if ( Q_stristr( Color::StripColors( name ), filter ) )
-		{
-			char data[ MAX_INFO_STRING ] = { 0 };
 
-			Info_SetValueForKey( data, "name", rocketInfo.data.servers[ netSrc ][ i ].name, false );
-			Info_SetValueForKey( data, "players", va( "%d", rocketInfo.data.servers[ netSrc ][ i ].clients ), false );
-			Info_SetValueForKey( data, "bots", va( "%d", rocketInfo.data.servers[ netSrc ][ i ].bots ), false );
-			Info_SetValueForKey( data, "ping", va( "%d", rocketInfo.data.servers[ netSrc ][ i ].ping ), false );
-			Info_SetValueForKey( data, "maxClients", va( "%d", rocketInfo.data.servers[ netSrc ][ i ].maxClients ), false );
-			Info_SetValueForKey( data, "addr", rocketInfo.data.servers[ netSrc ][ i ].addr, false );
-			Info_SetValueForKey( data, "label", rocketInfo.data.servers[ netSrc ][ i ].label, false );
+	Q_strncpyz( rocketInfo.data.serverFilter[ netSrc ], filter, sizeof( rocketInfo.data.serverFilter[ netSrc ] ) );
+	Q_strlwr( rocketInfo.data.serverFilter[ netSrc ] );
 
-			Rocket_DSAddRow( "server_browser", str, data );
-		}
-	}
+	EmitServerList( netSrc, str );
 }
 
 static void CG_Rocket_ExecServerList( const char *table )
 {
 	int netSrc = CG_StringToNetSource( table );
-	trap_SendConsoleCommand( va( "connect %s", rocketInfo.data.servers[ netSrc ][ rocketInfo.data.serverIndex[ netSrc ] ].addr ) );
+	int serverIndex = rocketInfo.data.serverIndex[ netSrc ];
+
+	if ( serverIndex < 0 || serverIndex >= rocketInfo.data.serverCount[ netSrc ] )
+	{
+		return;
+	}
+
+	trap_SendConsoleCommand( va( "connect %s", rocketInfo.data.servers[ netSrc ][ serverIndex ].addr ) );
 }
 
 static bool Parse( const char **p, char **out )
@@ -539,7 +622,7 @@ static void CG_Rocket_BuildResolutionList( const char* )
 	// Sort resolutions by size by default (larger first).
 	std::sort(rocketInfo.data.resolutions,rocketInfo.data.resolutions+rocketInfo.data.resolutionCount,[](const resolution_t&a, const resolution_t& b){return a.width*a.height > b.width*b.height;});
 
-	Rocket_DSClearTable( "resolutions", "default" );
+	Rocket_DSBeginTable( "resolutions", "default" );
 
 	for ( i = 0; i < rocketInfo.data.resolutionCount; ++i )
 	{
@@ -676,6 +759,7 @@ static void CG_Rocket_BuildLanguageList( const char* )
 	}
 
 	buf[ 0 ] = '\0';
+	Rocket_DSBeginTable( "languages", "default" );
 
 	for ( index = 0; index < rocketInfo.data.languageCount; ++index )
 	{
@@ -757,6 +841,7 @@ static void CG_Rocket_BuildAlOutputs( const char* )
 	}
 
 	buf[ 0 ] = '\0';
+	Rocket_DSBeginTable( "alOutputs", "default" );
 
 	for ( outputs = 0; outputs < rocketInfo.data.alOutputsCount; ++outputs )
 	{
@@ -812,6 +897,7 @@ static void CG_Rocket_BuildModList( const char* )
 	}
 
 	dirlist[ 0 ] = '\0';
+	Rocket_DSBeginTable( "modList", "default" );
 
 	for ( i = 0; i < rocketInfo.data.modCount; ++i )
 	{
@@ -883,6 +969,7 @@ static void CG_Rocket_BuildDemoList( const char* )
 	}
 
 	demolist[ 0 ] = '\0';
+	Rocket_DSBeginTable( "demoList", "default" );
 
 	for ( i = 0; i < rocketInfo.data.demoCount; ++i )
 	{
@@ -920,9 +1007,9 @@ void CG_Rocket_BuildPlayerList( const char* )
 	}
 
 	// Clear old values. Always build all three teams.
-	Rocket_DSClearTable( "playerList", "spectators" );
-	Rocket_DSClearTable( "playerList", "aliens" );
-	Rocket_DSClearTable( "playerList", "humans" );
+	Rocket_DSBeginTable( "playerList", "spectators" );
+	Rocket_DSBeginTable( "playerList", "aliens" );
+	Rocket_DSBeginTable( "playerList", "humans" );
 
 	for ( i = 0; i < cg.numScores; ++i )
 	{
@@ -1001,9 +1088,9 @@ static void CG_Rocket_SortPlayerList( const char*, const char *sortBy )
 	}
 
 	// Clear old values. Always build all three teams.
-	Rocket_DSClearTable( "playerList", "spectators" );
-	Rocket_DSClearTable( "playerList", "aliens" );
-	Rocket_DSClearTable( "playerList", "humans" );
+	Rocket_DSBeginTable( "playerList", "spectators" );
+	Rocket_DSBeginTable( "playerList", "aliens" );
+	Rocket_DSBeginTable( "playerList", "humans" );
 
 	for ( i = 0; i < rocketInfo.data.playerCount[ TEAM_NONE ]; ++i )
 	{
@@ -1073,7 +1160,7 @@ static void CG_Rocket_SortPlayerList( const char*, const char *sortBy )
 
 static void CG_Rocket_BuildMapList( const char* )
 {
-	Rocket_DSClearTable( "mapList", "default" );
+	Rocket_DSBeginTable( "mapList", "default" );
 	CG_LoadMapList();
 
 	for ( size_t i = 0; i < rocketInfo.data.mapList.size(); ++i )
@@ -1135,7 +1222,7 @@ static void CG_Rocket_BuildTeamList( const char* )
 
 	int i = 0;
 
-	Rocket_DSClearTable( "teamList", "default" );
+	Rocket_DSBeginTable( "teamList", "default" );
 
 	while ( data[ i ] )
 	{
@@ -1206,7 +1293,7 @@ static void CG_Rocket_BuildHumanSpawnItems( const char* )
 		return;
 	}
 
-	Rocket_DSClearTable( "humanSpawnItems", "default" );
+	Rocket_DSBeginTable( "humanSpawnItems", "default" );
 	AddHumanSpawnItem( WP_MACHINEGUN );
 	AddHumanSpawnItem( WP_HBUILD );
 }
@@ -1464,19 +1551,19 @@ static void CG_Rocket_BuildArmouryBuyList( const char *table )
 	if ( tblIndex == ROCKETDS_BOTH )
 	{
 		CG_Rocket_CleanUpArmouryBuyList( "default" );
-		Rocket_DSClearTable( "armouryBuyList", "default" );
+		Rocket_DSBeginTable( "armouryBuyList", "default" );
 	}
 
 	if ( tblIndex == ROCKETDS_BOTH || tblIndex == ROCKETDS_WEAPONS )
 	{
 		CG_Rocket_CleanUpArmouryBuyList( "weapons" );
-		Rocket_DSClearTable( "armouryBuyList", "weapons" );
+		Rocket_DSBeginTable( "armouryBuyList", "weapons" );
 	}
 
 	if ( tblIndex == ROCKETDS_BOTH || tblIndex == ROCKETDS_UPGRADES )
 	{
 		CG_Rocket_CleanUpArmouryBuyList( "upgrades" );
-		Rocket_DSClearTable( "armouryBuyList", "upgrades" );
+		Rocket_DSBeginTable( "armouryBuyList", "upgrades" );
 	}
 
 
@@ -1545,7 +1632,7 @@ static void CG_Rocket_BuildAlienEvolveList( const char *table )
 		int i;
 		float price;
 
-		Rocket_DSClearTable( "alienEvolveList", "default" );
+		Rocket_DSBeginTable( "alienEvolveList", "default" );
 		CG_Rocket_CleanUpAlienEvolveList( "default" );
 
 		for ( i = 0; i < PCL_NUM_CLASSES; ++i )
@@ -1621,7 +1708,7 @@ static void CG_Rocket_BuildHumanBuildList( const char *table )
 	{
 		int i;
 
-		Rocket_DSClearTable( "humanBuildList", "default" );
+		Rocket_DSBeginTable( "humanBuildList", "default" );
 		CG_Rocket_CleanUpHumanBuildList( "default" );
 
 		for ( i = BA_NONE + 1; i < BA_NUM_BUILDABLES; ++i )
@@ -1667,7 +1754,7 @@ static void CG_Rocket_BuildAlienBuildList( const char *table )
 	{
 		int i;
 
-		Rocket_DSClearTable( "alienBuildList", "default" );
+		Rocket_DSBeginTable( "alienBuildList", "default" );
 		CG_Rocket_CleanUpAlienBuildList( "default" );
 
 		for ( i = BA_NONE + 1; i < BA_NUM_BUILDABLES; ++i )
@@ -1719,7 +1806,7 @@ static void CG_Rocket_BuildAlienSpawnList( const char *table )
 
 	if ( !Q_stricmp( table, "default" ) )
 
-		Rocket_DSClearTable( "alienSpawnClass", "default" );
+		Rocket_DSBeginTable( "alienSpawnClass", "default" );
 
 	{
 		AddAlienSpawnClass( PCL_ALIEN_LEVEL0 );
@@ -1790,7 +1877,7 @@ static void CG_Rocket_BuildBeaconList( const char *table )
 		int i;
 		const beaconAttributes_t *ba;
 
-		Rocket_DSClearTable( "beaconList", "default" );
+		Rocket_DSBeginTable( "beaconList", "default" );
 		CG_Rocket_CleanUpBeaconList( "default" );
 
 		for ( i = BCT_NONE + 1; i < NUM_BEACON_TYPES; i++ )
@@ -1892,6 +1979,7 @@ void CG_Rocket_BuildDataSource( const char *dataSrc, const char *table )
 	{
 		cmd->cleanup( table );
 		cmd->build( table );
+		Rocket_DSCommitTables();
 	}
 }
 
@@ -1904,6 +1992,7 @@ void CG_Rocket_SortDataSource( const char *dataSource, const char *name, const c
 	if ( cmd && cmd->sort )
 	{
 		cmd->sort( name, sortBy );
+		Rocket_DSCommitTables();
 	}
 }
 
@@ -1928,6 +2017,7 @@ void CG_Rocket_FilterDataSource( const char *dataSource, const char *table, cons
 	if ( cmd && cmd->filter )
 	{
 		cmd->filter( table, filter );
+		Rocket_DSCommitTables();
 	}
 }
 
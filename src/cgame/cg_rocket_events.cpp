@@ -69,6 +69,10 @@ static void CG_Rocket_EventHide()
 static void CG_Rocket_InitServers()
 {
 	const char *src = CG_Argv( 1 );
+
+	// the LAN indexes the list is keyed by are about to be renumbered
+	CG_Rocket_CleanUpServerList( src );
+
 	trap_LAN_ResetPings( CG_StringToNetSource( src ) );
 	trap_LAN_ResetServerStatus();
 
@@ -286,6 +290,7 @@ static void CG_Rocket_EventPlay()
 static void CG_Rocket_ResetPings()
 {
 	const char *src = CG_Argv( 1 );
+	CG_Rocket_CleanUpServerList( src );
 	trap_LAN_ResetPings( CG_StringToNetSource( src ) );
 	trap_LAN_UpdateVisiblePings( CG_StringToNetSource( src ) );
 }
@@ -980,7 +980,7 @@ static voiceTrack_t *CG_VoiceTrack( char *voice, int cmd, int track )
 		return nullptr;
 	}
 
-	c = BG_VoiceCmdByNum( v->cmds, cmd );
+	c = BG_VoiceCmdByNum( v, cmd );
 
 	if ( !c )
 	{
@@ -989,7 +989,7 @@ static voiceTrack_t *CG_VoiceTrack( char *voice, int cmd, int track )
 		return nullptr;
 	}
 
-	t = BG_VoiceTrackByNum( c->tracks, track );
+	t = BG_VoiceTrackByNum( c, track );
 
 	if ( !t )
 	{
@@ -66,6 +66,9 @@ static void CG_TransitionEntity( centity_t *cent )
 	cent->currentState = cent->nextState;
 	cent->currentValid = true;
 
+	// the new state may describe a different kind of entity
+	CG_CheckRenderCache( cent );
+
 	// reset if the entity wasn't in the last frame or was teleported
 	if ( !cent->interpolate )
 	{
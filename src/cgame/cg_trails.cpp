@@ -38,6 +38,18 @@ static int               numBaseTrailBeams = 0;
 static trailSystem_t     trailSystems[ MAX_TRAIL_SYSTEMS ];
 static trailBeam_t       trailBeams[ MAX_TRAIL_BEAMS ];
 
+/*
+===============
+CG_BeamNode
+
+Returns the node at some index from the front of a beam
+===============
+*/
+static inline trailBeamNode_t *CG_BeamNode( trailBeam_t *tb, int index )
+{
+	return &tb->nodes[ ( tb->firstNode + index ) & ( MAX_TRAIL_BEAM_NODES - 1 ) ];
+}
+
 /*
 ===============
 CG_CalculateBeamNodeProperties
@@ -57,7 +69,7 @@ static void CG_CalculateBeamNodeProperties( trailBeam_t *tb )
 	vec3_t          colorRange;
 	float           fadeAlpha = 1.0f;
 
-	if ( !tb || !tb->nodes )
+	if ( !tb || !tb->numNodes )
 	{
 		return;
 	}
@@ -84,10 +96,10 @@ alphaRange = tb->class_->backAlpha -
 	VectorSubtract( tb->class_->backColor,
 	                tb->class_->frontColor, colorRange );
 
-	for ( i = tb->nodes; i && i->next; i = i->next )
+	for ( numNodes = 0; numNodes < tb->numNodes - 1; numNodes++ )
 {
-		nodeDistances[ numNodes++ ] =
-		  Distance( i->position, i->next->position );
+		nodeDistances[ numNodes ] =
+		  Distance( CG_BeamNode( tb, numNodes )->position, CG_BeamNode( tb, numNodes + 1 )->position );
 	}
 
 	for ( j = 0; j < numNodes; j++ )
@@ -101,8 +113,10 @@ alphaRange = tb->class_->backAlpha -
 		totalDistance = 1e-6f;
 	}
 
-	for ( j = 0, i = tb->nodes; i; i = i->next, j++ )
+	for ( j = 0; j < tb->numNodes; j++ )
 	{
+		i = CG_BeamNode( tb, j );
+
 		if ( tb->class_->textureType == TBTT_STRETCH )
 		{
 			i->textureCoord = tb->class_->frontTextureCoord +
@@ -128,7 +142,10 @@ alphaRange = tb->class_->backAlpha -
 		VectorMA( tb->class_->frontColor, ( position / totalDistance ),
 		          colorRange, i->color );
 
-		position += nodeDistances[ j ];
+		if ( j < numNodes )
+		{
+			position += nodeDistances[ j ];
+		}
 	}
 }
 
@@ -142,9 +159,9 @@ Lights a particular vertex
 static void CG_LightVertex( vec3_t point, byte alpha, byte *rgba )
 {
 	int    i;
-	vec3_t alight, dlight, lightdir;
+	vec3_t alight;
 
-	trap_R_LightForPoint( point, alight, dlight, lightdir );
+	CG_AmbientLightForPoint( point, alight );
 
 	for ( i = 0; i <= 2; i++ )
 	{
@@ -154,6 +171,55 @@ static void CG_LightVertex( vec3_t point, byte alpha, byte *rgba )
 	rgba[ 3 ] = alpha;
 }
 
+/*
+===============
+Beam polygon batching
+
+Every beam's quads are collected during CG_AddTrails and handed to the
+renderer with one trap_R_AddPolysToScene call per shader once all the
+beams have been updated.
+===============
+*/
+struct trailPolyRun_t
+{
+	qhandle_t shader;
+	int       firstVert;
+	int       numVerts;
+};
+
+static std::vector<polyVert_t>     trailPolyVerts;
+static std::vector<polyVert_t>     trailBatchVerts;
+static std::vector<trailPolyRun_t> trailPolyRuns;
+
+/*
+===============
+CG_BeamVertex
+
+Adds a vertex at some distance along the up vector from a node
+===============
+*/
+static void CG_BeamVertex( const baseTrailBeam_t *btb, trailBeamNode_t *i, const vec3_t up,
+                           float side )
+{
+	polyVert_t vert;
+
+	VectorMA( i->position, side * i->halfWidth, up, vert.xyz );
+	vert.st[ 0 ] = i->textureCoord;
+	vert.st[ 1 ] = side > 0.0f ? 1.0f : 0.0f;
+
+	if ( btb->realLight )
+	{
+		CG_LightVertex( vert.xyz, i->alpha, vert.modulate );
+	}
+	else
+	{
+		VectorCopy( i->color, vert.modulate );
+		vert.modulate[ 3 ] = i->alpha;
+	}
+
+	trailPolyVerts.push_back( vert );
+}
+
 /*
 ===============
 CG_RenderBeam
@@ -167,13 +233,12 @@ static void CG_RenderBeam( trailBeam_t *tb )
 	trailBeamNode_t   *prev = nullptr;
 	trailBeamNode_t   *next = nullptr;
 	vec3_t            up;
-	polyVert_t        verts[( MAX_TRAIL_BEAM_NODES - 1 ) * 4 ];
-	int               numVerts = 0;
+	trailPolyRun_t    run;
 	baseTrailBeam_t   *btb;
 	trailSystem_t     *ts;
 	baseTrailSystem_t *bts;
 
-	if ( !tb || !tb->nodes )
+	if ( !tb || !tb->numNodes )
 	{
 		return;
 	}
@@ -192,12 +257,14 @@ static void CG_RenderBeam( trailBeam_t *tb )
 
 	CG_CalculateBeamNodeProperties( tb );
 
-	i = tb->nodes;
+	run.shader = btb->shader;
+	run.firstVert = ( int ) trailPolyVerts.size();
 
-	do
+	for ( int j = 0; j < tb->numNodes; j++ )
 	{
-		prev = i->prev;
-		next = i->next;
+		i = CG_BeamNode( tb, j );
+		prev = j > 0 ? CG_BeamNode( tb, j - 1 ) : nullptr;
+		next = j < tb->numNodes - 1 ? CG_BeamNode( tb, j + 1 ) : nullptr;
 
 		if ( prev && next )
 		{
@@ -221,72 +288,14 @@ static void CG_RenderBeam( trailBeam_t *tb )
 
 		if ( prev )
 		{
-			VectorMA( i->position, i->halfWidth, up, verts[ numVerts ].xyz );
-			verts[ numVerts ].st[ 0 ] = i->textureCoord;
-			verts[ numVerts ].st[ 1 ] = 1.0f;
-
-			if ( btb->realLight )
-			{
-				CG_LightVertex( verts[ numVerts ].xyz, i->alpha, verts[ numVerts ].modulate );
-			}
-			else
-			{
-				VectorCopy( i->color, verts[ numVerts ].modulate );
-				verts[ numVerts ].modulate[ 3 ] = i->alpha;
-			}
-
-			numVerts++;
-
-			VectorMA( i->position, -i->halfWidth, up, verts[ numVerts ].xyz );
-			verts[ numVerts ].st[ 0 ] = i->textureCoord;
-			verts[ numVerts ].st[ 1 ] = 0.0f;
-
-			if ( btb->realLight )
-			{
-				CG_LightVertex( verts[ numVerts ].xyz, i->alpha, verts[ numVerts ].modulate );
-			}
-			else
-			{
-				VectorCopy( i->color, verts[ numVerts ].modulate );
-				verts[ numVerts ].modulate[ 3 ] = i->alpha;
-			}
-
-			numVerts++;
+			CG_BeamVertex( btb, i, up, 1.0f );
+			CG_BeamVertex( btb, i, up, -1.0f );
 		}
 
 		if ( next )
 		{
-			VectorMA( i->position, -i->halfWidth, up, verts[ numVerts ].xyz );
-			verts[ numVerts ].st[ 0 ] = i->textureCoord;
-			verts[ numVerts ].st[ 1 ] = 0.0f;
-
-			if ( btb->realLight )
-			{
-				CG_LightVertex( verts[ numVerts ].xyz, i->alpha, verts[ numVerts ].modulate );
-			}
-			else
-			{
-				VectorCopy( i->color, verts[ numVerts ].modulate );
-				verts[ numVerts ].modulate[ 3 ] = i->alpha;
-			}
-
-			numVerts++;
-
-			VectorMA( i->position, i->halfWidth, up, verts[ numVerts ].xyz );
-			verts[ numVerts ].st[ 0 ] = i->textureCoord;
-			verts[ numVerts ].st[ 1 ] = 1.0f;
-
-			if ( btb->realLight )
-			{
-				CG_LightVertex( verts[ numVerts ].xyz, i->alpha, verts[ numVerts ].modulate );
-			}
-			else
-			{
-				VectorCopy( i->color, verts[ numVerts ].modulate );
-				verts[ numVerts ].modulate[ 3 ] = i->alpha;
-			}
-
-			numVerts++;
+			CG_BeamVertex( btb, i, up, -1.0f );
+			CG_BeamVertex( btb, i, up, 1.0f );
 		}
 
 		if( btb->dynamicLight ) {
@@ -297,130 +306,76 @@ static void CG_RenderBeam( trailBeam_t *tb )
 						( float ) btb->dLightColor[ 1 ] / ( float ) 0xFF,
 						( float ) btb->dLightColor[ 2 ] / ( float ) 0xFF, 0, 0 );
 		}
-
-		i = i->next;
 	}
-	while ( i );
 
-	trap_R_AddPolysToScene( tb->class_->shader, 4, &verts[ 0 ], numVerts / 4 );
-}
+	run.numVerts = ( int ) trailPolyVerts.size() - run.firstVert;
 
-/*
-===============
-CG_AllocateBeamNode
-
-Allocates a trailBeamNode_t from a trailBeam_t's nodePool
-===============
-*/
-static trailBeamNode_t *CG_AllocateBeamNode( trailBeam_t *tb )
-{
-	baseTrailBeam_t *btb = tb->class_;
-	int             i;
-	trailBeamNode_t *tbn;
-
-	for ( i = 0; i < MAX_TRAIL_BEAM_NODES; i++ )
+	if ( run.numVerts )
 	{
-		tbn = &tb->nodePool[ i ];
-
-		if ( !tbn->used )
-		{
-			tbn->timeLeft = btb->segmentTime;
-			tbn->prev = nullptr;
-			tbn->next = nullptr;
-			tbn->used = true;
-			return tbn;
-		}
+		trailPolyRuns.push_back( run );
 	}
-
-	// no space left
-	return nullptr;
 }
 
 /*
 ===============
-CG_DestroyBeamNode
+CG_FlushBeamPolys
 
-Removes a node from a beam
-Returns the new head
+Submit the quads of all the beams rendered this frame, grouped by shader
 ===============
 */
-static trailBeamNode_t *CG_DestroyBeamNode( trailBeamNode_t *tbn )
+static void CG_FlushBeamPolys()
 {
-	trailBeamNode_t *newHead = nullptr;
-
-	if ( tbn->prev )
-	{
-		if ( tbn->next )
-		{
-			// node is in the middle
-			tbn->prev->next = tbn->next;
-			tbn->next->prev = tbn->prev;
-		}
-		else // node is at the back
-		{
-			tbn->prev->next = nullptr;
-		}
+	size_t start = 0;
 
-		// find the new head (shouldn't have changed)
-		newHead = tbn->prev;
+	std::stable_sort( trailPolyRuns.begin(), trailPolyRuns.end(),
+	                  []( const trailPolyRun_t &a, const trailPolyRun_t &b ) {
+		return a.shader < b.shader;
+	} );
 
-		while ( newHead->prev )
-		{
-			newHead = newHead->prev;
-		}
-	}
-	else if ( tbn->next )
+	while ( start < trailPolyRuns.size() )
 	{
-		//node is at the front
-		tbn->next->prev = nullptr;
-		newHead = tbn->next;
-	}
+		qhandle_t shader = trailPolyRuns[ start ].shader;
 
-	tbn->prev = nullptr;
-	tbn->next = nullptr;
-	tbn->used = false;
-
-	return newHead;
-}
+		trailBatchVerts.clear();
 
-/*
-===============
-CG_FindLastBeamNode
+		for ( ; start < trailPolyRuns.size() && trailPolyRuns[ start ].shader == shader; start++ )
+		{
+			const trailPolyRun_t &run = trailPolyRuns[ start ];
 
-Returns the last beam node in a beam
-===============
-*/
-static trailBeamNode_t *CG_FindLastBeamNode( trailBeam_t *tb )
-{
-	trailBeamNode_t *i = tb->nodes;
+			trailBatchVerts.insert( trailBatchVerts.end(),
+			                        trailPolyVerts.begin() + run.firstVert,
+			                        trailPolyVerts.begin() + run.firstVert + run.numVerts );
+		}
 
-	while ( i && i->next )
-	{
-		i = i->next;
+		trap_R_AddPolysToScene( shader, 4, trailBatchVerts.data(), ( int ) trailBatchVerts.size() / 4 );
 	}
 
-	return i;
+	trailPolyVerts.clear();
+	trailPolyRuns.clear();
 }
 
 /*
 ===============
-CG_CountBeamNodes
+CG_AppendBeamNode
 
-Returns the number of nodes in a beam
+Append a new beam node to the back of a beam
+Returns the new node
 ===============
 */
-static int CG_CountBeamNodes( trailBeam_t *tb )
+static trailBeamNode_t *CG_AppendBeamNode( trailBeam_t *tb )
 {
-	trailBeamNode_t *i = tb->nodes;
-	int             numNodes = 0;
+	trailBeamNode_t *i;
 
-	while ( i )
+	// no space left
+	if ( tb->numNodes >= MAX_TRAIL_BEAM_NODES )
 	{
-		numNodes++;
-		i = i->next;
+		return nullptr;
 	}
 
-	return numNodes;
+	i = CG_BeamNode( tb, tb->numNodes++ );
+	i->timeLeft = tb->class_->segmentTime;
+
+	return i;
 }
 
 /*
@@ -435,65 +390,17 @@ static trailBeamNode_t *CG_PrependBeamNode( trailBeam_t *tb )
 {
 	trailBeamNode_t *i;
 
-	if ( tb->nodes )
-	{
-		// prepend another node
-		i = CG_AllocateBeamNode( tb );
-
-		if ( i )
-		{
-			i->next = tb->nodes;
-			tb->nodes->prev = i;
-			tb->nodes = i;
-		}
-	}
-	else //add first node
+	// no space left
+	if ( tb->numNodes >= MAX_TRAIL_BEAM_NODES )
 	{
-		i = CG_AllocateBeamNode( tb );
-
-		if ( i )
-		{
-			tb->nodes = i;
-		}
+		return nullptr;
 	}
 
-	return i;
-}
-
-/*
-===============
-CG_AppendBeamNode
-
-Append a new beam node to the back of a beam
-Returns the new node
-===============
-*/
-static trailBeamNode_t *CG_AppendBeamNode( trailBeam_t *tb )
-{
-	trailBeamNode_t *last, *i;
-
-	if ( tb->nodes )
-	{
-		// append another node
-		last = CG_FindLastBeamNode( tb );
-		i = CG_AllocateBeamNode( tb );
-
-		if ( i )
-		{
-			last->next = i;
-			i->prev = last;
-			i->next = nullptr;
-		}
-	}
-	else //add first node
-	{
-		i = CG_AllocateBeamNode( tb );
+	tb->firstNode = ( tb->firstNode - 1 ) & ( MAX_TRAIL_BEAM_NODES - 1 );
+	tb->numNodes++;
 
-		if ( i )
-		{
-			tb->nodes = i;
-		}
-	}
+	i = CG_BeamNode( tb, 0 );
+	i->timeLeft = tb->class_->segmentTime;
 
 	return i;
 }
@@ -506,13 +413,13 @@ CG_ApplyJitters
 static void CG_ApplyJitters( trailBeam_t *tb )
 {
 	trailBeamNode_t *i = nullptr;
-	int             j;
+	int             j, k;
 	baseTrailBeam_t *btb;
 	trailSystem_t   *ts;
-	trailBeamNode_t *start;
-	trailBeamNode_t *end;
+	int             start;
+	int             end;
 
-	if ( !tb || !tb->nodes )
+	if ( !tb || !tb->numNodes )
 	{
 		return;
 	}
@@ -524,8 +431,9 @@ static void CG_ApplyJitters( trailBeam_t *tb )
 	{
 		if ( tb->nextJitterTimes[ j ] <= cg.time )
 		{
-			for ( i = tb->nodes; i; i = i->next )
+			for ( k = 0; k < tb->numNodes; k++ )
 			{
+				i = CG_BeamNode( tb, k );
 				i->jitters[ j ][ 0 ] = ( crandom() * btb->jitters[ j ].magnitude );
 				i->jitters[ j ][ 1 ] = ( crandom() * btb->jitters[ j ].magnitude );
 			}
@@ -534,31 +442,32 @@ static void CG_ApplyJitters( trailBeam_t *tb )
 		}
 	}
 
-	start = tb->nodes;
-	end = CG_FindLastBeamNode( tb );
+	start = 0;
+	end = tb->numNodes - 1;
 
 	if ( !btb->jitterAttachments )
 	{
-		if ( CG_Attached( &ts->frontAttachment ) && start->next )
+		if ( CG_Attached( &ts->frontAttachment ) && tb->numNodes > 1 )
 		{
-			start = start->next;
+			start++;
 		}
 
-		if ( CG_Attached( &ts->backAttachment ) && end->prev )
+		if ( CG_Attached( &ts->backAttachment ) && end > 0 )
 		{
-			end = end->prev;
+			end--;
 		}
 	}
 
-	for ( i = start; i; i = i->next )
+	for ( k = start; k < tb->numNodes; k++ )
 	{
 		vec3_t          forward, right, up;
 		trailBeamNode_t *prev;
 		trailBeamNode_t *next;
 		float           upJitter = 0.0f, rightJitter = 0.0f;
 
-		prev = i->prev;
-		next = i->next;
+		i = CG_BeamNode( tb, k );
+		prev = k > 0 ? CG_BeamNode( tb, k - 1 ) : nullptr;
+		next = k < tb->numNodes - 1 ? CG_BeamNode( tb, k + 1 ) : nullptr;
 
 		if ( prev && next )
 		{
@@ -600,7 +509,7 @@ static void CG_ApplyJitters( trailBeam_t *tb )
 		VectorMA( i->position, upJitter, up, i->position );
 		VectorMA( i->position, rightJitter, right, i->position );
 
-		if ( i == end )
+		if ( k == end )
 		{
 			break;
 		}
@@ -622,7 +531,6 @@ static void CG_UpdateBeam( trailBeam_t *tb )
 	int             deltaTime;
 	int             nodesToAdd;
 	int             j;
-	int             numNodes;
 
 	if ( !tb )
 	{
@@ -638,13 +546,18 @@ static void CG_UpdateBeam( trailBeam_t *tb )
 	// first make sure this beam has enough nodes
 	if ( ts->destroyTime <= 0 )
 	{
-		nodesToAdd = btb->numSegments - CG_CountBeamNodes( tb ) + 1;
+		nodesToAdd = btb->numSegments - tb->numNodes + 1;
 
-		while ( nodesToAdd-- )
+		while ( nodesToAdd-- > 0 )
 		{
 			i = CG_AppendBeamNode( tb );
 
-			if ( !tb->nodes->next && CG_Attached( &ts->frontAttachment ) )
+			if ( !i )
+			{
+				break;
+			}
+
+			if ( tb->numNodes == 1 && CG_Attached( &ts->frontAttachment ) )
 			{
 				// this is the first node to be added
 				if ( !CG_AttachmentPoint( &ts->frontAttachment, i->refPosition ) )
@@ -652,17 +565,16 @@ static void CG_UpdateBeam( trailBeam_t *tb )
 					CG_DestroyTrailSystem( ts );
 				}
 			}
-			else
+			else if ( tb->numNodes > 1 )
 			{
-				VectorCopy( i->prev->refPosition, i->refPosition );
+				VectorCopy( CG_BeamNode( tb, tb->numNodes - 2 )->refPosition, i->refPosition );
 			}
 		}
 	}
 
-	numNodes = CG_CountBeamNodes( tb );
-
-	for ( i = tb->nodes; i; i = i->next )
+	for ( j = 0; j < tb->numNodes; j++ )
 	{
+		i = CG_BeamNode( tb, j );
 		VectorCopy( i->refPosition, i->position );
 	}
 
@@ -684,11 +596,11 @@ static void CG_UpdateBeam( trailBeam_t *tb )
 
 		VectorSubtract( back, front, dir );
 
-		for ( j = 0, i = tb->nodes; i; i = i->next, j++ )
+		for ( j = 0; j < tb->numNodes; j++ )
 		{
-			float scale = ( float ) j / ( float )( numNodes - 1 );
+			float scale = ( float ) j / ( float )( tb->numNodes - 1 );
 
-			VectorMA( front, scale, dir, i->position );
+			VectorMA( front, scale, dir, CG_BeamNode( tb, j )->position );
 		}
 	}
 	else if ( CG_Attached( &ts->frontAttachment ) )
@@ -696,17 +608,15 @@ static void CG_UpdateBeam( trailBeam_t *tb )
 		// beam from one attachment
 
 		// cull the trail tail
-		i = CG_FindLastBeamNode( tb );
-
-		if ( i && i->timeLeft >= 0 )
+		if ( tb->numNodes && ( i = CG_BeamNode( tb, tb->numNodes - 1 ) )->timeLeft >= 0 )
 		{
 			i->timeLeft -= deltaTime;
 
 			if ( i->timeLeft < 0 )
 			{
-				tb->nodes = CG_DestroyBeamNode( i );
+				tb->numNodes--;
 
-				if ( !tb->nodes )
+				if ( !tb->numNodes )
 				{
 					tb->valid = false;
 					return;
@@ -718,27 +628,30 @@ static void CG_UpdateBeam( trailBeam_t *tb )
 					CG_PrependBeamNode( tb );
 				}
 			}
-			else if ( i->timeLeft >= 0 && i->prev )
+			else if ( tb->numNodes > 1 )
 			{
-				vec3_t dir;
-				float  length;
+				trailBeamNode_t *prev = CG_BeamNode( tb, tb->numNodes - 2 );
+				vec3_t          dir;
+				float           length;
 
-				VectorSubtract( i->refPosition, i->prev->refPosition, dir );
+				VectorSubtract( i->refPosition, prev->refPosition, dir );
 				length = VectorNormalize( dir ) *
 				         ( ( float ) i->timeLeft / ( float ) tb->class_->segmentTime );
 
-				VectorMA( i->prev->refPosition, length, dir, i->position );
+				VectorMA( prev->refPosition, length, dir, i->position );
 			}
 		}
 
-		if ( tb->nodes )
+		if ( tb->numNodes )
 		{
-			if ( !CG_AttachmentPoint( &ts->frontAttachment, tb->nodes->refPosition ) )
+			trailBeamNode_t *front = CG_BeamNode( tb, 0 );
+
+			if ( !CG_AttachmentPoint( &ts->frontAttachment, front->refPosition ) )
 			{
 				CG_DestroyTrailSystem( ts );
 			}
 
-			VectorCopy( tb->nodes->refPosition, tb->nodes->position );
+			VectorCopy( front->refPosition, front->position );
 		}
 	}
 
@@ -1613,6 +1526,8 @@ void CG_AddTrails()
 		}
 	}
 
+	CG_FlushBeamPolys();
+
 	logs.DoDebugCode([] {
 		int numTS = 0, numTB = 0;
 		for ( int i = 0; i < MAX_TRAIL_SYSTEMS; i++ )
@@ -41,6 +41,7 @@ const char* Trans_Gettext( const char *msgid ) PRINTF_TRANSLATE_ARG(1);
 const char* Trans_Pgettext( const char *ctxt, const char *msgid ) PRINTF_TRANSLATE_ARG(2);
 const char* Trans_GettextPlural( const char *msgid, const char *msgid_plural, int num ) PRINTF_TRANSLATE_ARG(1);
 void Trans_UpdateLanguage_f();
+void Trans_Stats_f();
 void Trans_Init();
 
 //
@@ -1963,4 +1963,7 @@ void CG_DrawActiveFrame( int serverTime, bool demoPlayback )
 
 	// actually issue the rendering calls
 	CG_DrawActive();
+
+	// spend what is left of the frame budget on models needed later
+	CG_RunClientModelQueue();
 }
@@ -1249,6 +1249,110 @@ static float CG_MachinegunSpinAngle( centity_t *cent, bool firing )
 	return angle;
 }
 
+/*
+=============
+CG_PlayerWeaponFiring
+
+Whether an entity is firing its weapon in the mode it has selected
+=============
+*/
+static bool CG_PlayerWeaponFiring( const centity_t *cent, weaponMode_t *weaponMode )
+{
+	*weaponMode = (weaponMode_t) cent->currentState.generic1;
+
+	if ( *weaponMode <= WPM_NONE || *weaponMode >= WPM_NUM_WEAPONMODES )
+	{
+		*weaponMode = WPM_PRIMARY;
+	}
+
+	return ( ( cent->currentState.eFlags & EF_FIRING ) && *weaponMode == WPM_PRIMARY ) ||
+	       ( ( cent->currentState.eFlags & EF_FIRING2 ) && *weaponMode == WPM_SECONDARY ) ||
+	       ( ( cent->currentState.eFlags & EF_FIRING3 ) && *weaponMode == WPM_TERTIARY );
+}
+
+/*
+=============
+CG_AddPlayerWeaponSounds
+
+The looping sounds of a weapon, also played when it is out of view
+=============
+*/
+void CG_AddPlayerWeaponSounds( playerState_t *ps, centity_t *cent )
+{
+	weapon_t     weaponNum = (weapon_t) cent->currentState.weapon;
+	weaponMode_t weaponMode;
+	bool         firing = CG_PlayerWeaponFiring( cent, &weaponMode );
+	weaponInfo_t *weapon = &cg_weapons[ weaponNum ];
+
+	if ( !weapon->registered )
+	{
+		return;
+	}
+
+	if ( !ps )
+	{
+		// add weapon ready sound
+		if ( firing && weapon->wim[ weaponMode ].firingSound )
+		{
+			trap_S_AddLoopingSound( cent->currentState.number, cent->lerpOrigin, vec3_origin,
+			                        weapon->wim[ weaponMode ].firingSound );
+		}
+		else if ( weapon->readySound )
+		{
+			trap_S_AddLoopingSound( cent->currentState.number, cent->lerpOrigin, vec3_origin, weapon->readySound );
+		}
+	}
+
+	// Lucifer cannon charge warning beep
+	if ( weaponNum == WP_LUCIFER_CANNON && ( cent->currentState.eFlags & EF_WARN_CHARGE ) )
+	{
+		trap_S_AddLoopingSound( cent->currentState.number, cent->lerpOrigin,
+		                        vec3_origin, ps ? cgs.media.lCannonWarningSound :
+		                        cgs.media.lCannonWarningSound2 );
+	}
+}
+
+/*
+=============
+CG_AddPlayerWeaponFlashLight
+
+The dlight of a muzzle flash, also added when the player is out of view
+since it can light what is in view, as long as its radius reaches it
+=============
+*/
+void CG_AddPlayerWeaponFlashLight( centity_t *cent, const vec3_t origin )
+{
+	weaponMode_t     weaponMode;
+	bool             firing = CG_PlayerWeaponFiring( cent, &weaponMode );
+	weaponInfo_t     *weapon = &cg_weapons[ cent->currentState.weapon ];
+	weaponInfoMode_t *wim = &weapon->wim[ weaponMode ];
+
+	if ( !weapon->registered )
+	{
+		return;
+	}
+
+	if ( !wim->flashDlightColor[ 0 ] && !wim->flashDlightColor[ 1 ] && !wim->flashDlightColor[ 2 ] )
+	{
+		return;
+	}
+
+	// impulse flash
+	if ( ( !wim->continuousFlash || !firing ) && cg.time - cent->muzzleFlashTime > MUZZLE_FLASH_TIME )
+	{
+		return;
+	}
+
+	if ( CG_CullPointAndRadius( origin, wim->flashDlight ) )
+	{
+		return;
+	}
+
+	trap_R_AddLightToScene( origin, wim->flashDlight, wim->flashDlightIntensity,
+	                        wim->flashDlightColor[ 0 ], wim->flashDlightColor[ 1 ],
+	                        wim->flashDlightColor[ 2 ], 0, 0 );
+}
+
 /*
 =============
 CG_AddPlayerWeapon
@@ -1268,23 +1372,7 @@ void CG_AddPlayerWeapon( refEntity_t *parent, playerState_t *ps, centity_t *cent
 	bool     firing;
 
 	weaponNum = (weapon_t) cent->currentState.weapon;
-	weaponMode = (weaponMode_t) cent->currentState.generic1;
-
-	if ( weaponMode <= WPM_NONE || weaponMode >= WPM_NUM_WEAPONMODES )
-	{
-		weaponMode = WPM_PRIMARY;
-	}
-
-	if ( ( ( cent->currentState.eFlags & EF_FIRING ) && weaponMode == WPM_PRIMARY ) ||
-	     ( ( cent->currentState.eFlags & EF_FIRING2 ) && weaponMode == WPM_SECONDARY ) ||
-	     ( ( cent->currentState.eFlags & EF_FIRING3 ) && weaponMode == WPM_TERTIARY ) )
-	{
-		firing = true;
-	}
-	else
-	{
-		firing = false;
-	}
+	firing = CG_PlayerWeaponFiring( cent, &weaponMode );
 
 	weapon = &cg_weapons[ weaponNum ];
 
@@ -1341,27 +1429,7 @@ void CG_AddPlayerWeapon( refEntity_t *parent, playerState_t *ps, centity_t *cent
 
 	noGunModel = ( ( !ps || cg.renderingThirdPerson ) && weapon->disableIn3rdPerson ) || !gun.hModel;
 
-	if ( !ps )
-	{
-		// add weapon ready sound
-		if ( firing && weapon->wim[ weaponMode ].firingSound )
-		{
-			trap_S_AddLoopingSound( cent->currentState.number, cent->lerpOrigin, vec3_origin,
-			                        weapon->wim[ weaponMode ].firingSound );
-		}
-		else if ( weapon->readySound )
-		{
-			trap_S_AddLoopingSound( cent->currentState.number, cent->lerpOrigin, vec3_origin, weapon->readySound );
-		}
-	}
-
-	// Lucifer cannon charge warning beep
-	if ( weaponNum == WP_LUCIFER_CANNON && ( cent->currentState.eFlags & EF_WARN_CHARGE ) )
-	{
-		trap_S_AddLoopingSound( cent->currentState.number, cent->lerpOrigin,
-		                        vec3_origin, ps ? cgs.media.lCannonWarningSound :
-		                        cgs.media.lCannonWarningSound2 );
-	}
+	CG_AddPlayerWeaponSounds( ps, cent );
 
 	if ( !noGunModel )
 	{
@@ -1532,16 +1600,7 @@ void CG_AddPlayerWeapon( refEntity_t *parent, playerState_t *ps, centity_t *cent
 		}
 
 		// make a dlight for the flash
-		if ( weapon->wim[ weaponMode ].flashDlightColor[ 0 ] ||
-		     weapon->wim[ weaponMode ].flashDlightColor[ 1 ] ||
-		     weapon->wim[ weaponMode ].flashDlightColor[ 2 ] )
-		{
-			trap_R_AddLightToScene( flash.origin, weapon->wim[ weaponMode ].flashDlight,
-			                        weapon->wim[ weaponMode ].flashDlightIntensity,
-			                        weapon->wim[ weaponMode ].flashDlightColor[ 0 ],
-			                        weapon->wim[ weaponMode ].flashDlightColor[ 1 ],
-			                        weapon->wim[ weaponMode ].flashDlightColor[ 2 ], 0, 0 );
-		}
+		CG_AddPlayerWeaponFlashLight( cent, flash.origin );
 	}
 }
 
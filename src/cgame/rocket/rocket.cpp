@@ -36,6 +36,7 @@ Maryland 20850 USA.
 
 #include "common/Common.h"
 #include "rocket.h"
+#include <list>
 #include <RmlUi/Core.h>
 #include <RmlUi/Lua/Lua.h>
 #include <RmlUi/Lua/Interpreter.h>
@@ -153,14 +154,12 @@ public:
 	}
 };
 
-static polyVert_t *createVertexArray( Rml::Vertex *vertices, int count )
+static void fillVertexArray( const Rml::Vertex *vertices, int count, polyVert_t *verts )
 {
-	polyVert_t *verts = new polyVert_t[ count ];
-
 	for ( int i = 0; i < count; i++ )
 	{
 		polyVert_t &polyVert = verts[ i ];
-		Rml::Vertex &vert = vertices[ i ];
+		const Rml::Vertex &vert = vertices[ i ];
 
 		Vector2Copy( vert.position, polyVert.xyz );
 
@@ -171,40 +170,43 @@ static polyVert_t *createVertexArray( Rml::Vertex *vertices, int count )
 
 		Vector2Copy( vert.tex_coord, polyVert.st );
 	}
-
-	return verts;
 }
 
 class RocketCompiledGeometry
 {
 public:
-	polyVert_t *verts;
-	int         numVerts;
-	int        *indices;
-	int         numIndicies;
-	qhandle_t   shader;
+	std::vector<polyVert_t> verts;
+	std::vector<int>        indices;
+	qhandle_t               shader;
 
-	RocketCompiledGeometry( Rml::Vertex *verticies, int numVerticies, int *_indices, int _numIndicies, qhandle_t shader ) : numVerts( numVerticies ), numIndicies( _numIndicies )
+	RocketCompiledGeometry( Rml::Vertex *verticies, int numVerticies, int *_indices, int _numIndicies, qhandle_t shader ) :
+		verts( numVerticies ), indices( _indices, _indices + _numIndicies ), shader( shader )
 	{
-		this->verts = createVertexArray( verticies, numVerticies );
-
-		this->indices = new int[ _numIndicies ];
-		memcpy( indices, _indices, _numIndicies * sizeof( int ) );
-
-		this->shader = shader;
-	}
-
-	~RocketCompiledGeometry()
-	{
-		delete[] verts;
-		delete[] indices;
+		fillVertexArray( verticies, numVerticies, verts.data() );
 	}
 };
 
+// Conversion buffer for RenderGeometry, kept between calls
+static std::vector<polyVert_t> transientVerts;
+
 // HACK: Rocket uses a texturehandle of 0 when we really want the whiteImage shader
 static qhandle_t whiteShader;
 
-// TODO: CompileGeometry, RenderCompiledGeometry, ReleaseCompileGeometry ( use vbos and ibos )
+// What the render interface handed to the renderer, per frame
+struct RocketGeometryStats
+{
+	int immediateCalls = 0;
+	int immediateVerts = 0;
+	int compiledCalls = 0;
+	int compiledVerts = 0;
+};
+
+static RocketGeometryStats geometryStats, lastFrameGeometryStats;
+
+// Vertices converted for compiled geometry that is still alive
+static int residentCompiledVerts = 0;
+
+// TODO: retain compiled geometry on the renderer side ( vbos and ibos ) once there is a trap for it
 class DaemonRenderInterface : public Rml::RenderInterface
 {
 public:
@@ -212,15 +214,25 @@ public:
 
 	void RenderGeometry( Rml::Vertex *verticies,  int numVerticies, int *indices, int numIndicies, Rml::TextureHandle texture, const Rml::Vector2f& translation ) override
 	{
-		polyVert_t *verts = createVertexArray( verticies, numVerticies );
-		trap_R_Add2dPolysIndexedToScene( verts, numVerticies, indices, numIndicies, translation.x, translation.y, texture ? ( qhandle_t ) texture : whiteShader );
-		delete[]  verts;
+		// reuse the same buffer every call, it only ever grows to the largest batch
+		if ( transientVerts.size() < static_cast<size_t>( numVerticies ) )
+		{
+			transientVerts.resize( numVerticies );
+		}
+
+		fillVertexArray( verticies, numVerticies, transientVerts.data() );
+		trap_R_Add2dPolysIndexedToScene( transientVerts.data(), numVerticies, indices, numIndicies, translation.x, translation.y, texture ? ( qhandle_t ) texture : whiteShader );
+
+		geometryStats.immediateCalls++;
+		geometryStats.immediateVerts += numVerticies;
 	}
 
 	Rml::CompiledGeometryHandle CompileGeometry( Rml::Vertex *vertices, int num_vertices, int *indices, int num_indices, Rml::TextureHandle texture ) override
 	{
 		RocketCompiledGeometry *geometry = new RocketCompiledGeometry( vertices, num_vertices, indices, num_indices, texture ? ( qhandle_t ) texture : whiteShader );
 
+		residentCompiledVerts += num_vertices;
+
 		return Rml::CompiledGeometryHandle( geometry );
 
 	}
@@ -228,12 +240,16 @@ public:
 	void RenderCompiledGeometry( Rml::CompiledGeometryHandle geometry, const Rml::Vector2f &translation ) override
 	{
 		RocketCompiledGeometry *g = ( RocketCompiledGeometry * ) geometry;
-		trap_R_Add2dPolysIndexedToScene( g->verts, g->numVerts, g->indices, g->numIndicies, translation.x, translation.y, g->shader );
+		trap_R_Add2dPolysIndexedToScene( g->verts.data(), static_cast<int>( g->verts.size() ), g->indices.data(), static_cast<int>( g->indices.size() ), translation.x, translation.y, g->shader );
+
+		geometryStats.compiledCalls++;
+		geometryStats.compiledVerts += static_cast<int>( g->verts.size() );
 	}
 
 	void ReleaseCompiledGeometry( Rml::CompiledGeometryHandle geometry ) override
 	{
 		RocketCompiledGeometry *g = ( RocketCompiledGeometry * ) geometry;
+		residentCompiledVerts -= static_cast<int>( g->verts.size() );
 		delete g;
 	}
 
@@ -458,6 +474,8 @@ static bool drawMenu;
 
 void Rocket_Render()
 {
+	geometryStats = {};
+
 	// cg.snap is not available on the first frame but some HUD code accesses it
 	if ( cg_draw2D.Get() && hudContext && cg.snap )
 	{
@@ -470,6 +488,17 @@ void Rocket_Render()
 		menuContext->Render();
 	}
 
+	lastFrameGeometryStats = geometryStats;
+}
+
+void Rocket_GeometryStats_f()
+{
+	const RocketGeometryStats &stats = lastFrameGeometryStats;
+
+	Log::Notice( "last frame: %d vertices in %d immediate batches, %d vertices in %d compiled batches",
+	             stats.immediateVerts, stats.immediateCalls, stats.compiledVerts, stats.compiledCalls );
+	Log::Notice( "%d vertices held in compiled geometry, %d in the immediate buffer",
+	             residentCompiledVerts, static_cast<int>( transientVerts.size() ) );
 }
 
 void Rocket_Update()
@@ -510,7 +539,7 @@ std::string CG_EscapeHTMLText( Str::StringRef text )
 
 // TODO: Make this take Rml::String as an input.
 // FIXME: This always parses colors even when RP_QUAKE is not specified. Many callers rely on this behavior.
-Rml::String Rocket_QuakeToRML( const char *in, int parseFlags = 0 )
+static Rml::String Rocket_ParseQuakeToRML( const char *in, int parseFlags )
 {
 	Rml::String out;
 	Rml::String spanstr;
@@ -617,6 +646,138 @@ Rml::String Rocket_QuakeToRML( const char *in, int parseFlags = 0 )
 	return out;
 }
 
+/*
+ * The same names, chat lines and HUD strings are converted every frame,
+ * so the most recently used conversions are kept. Long strings are
+ * passed through without being cached.
+ */
+#define QUAKE_TO_RML_CACHE_SIZE       512
+#define QUAKE_TO_RML_CACHE_MAX_LENGTH 1024
+
+struct QuakeToRMLCache
+{
+	// front is the most recently used, key is the parse flags followed by the input
+	std::list<std::pair<std::string, Rml::String>> entries;
+	std::unordered_map<std::string, decltype( entries )::iterator> index;
+
+	int plain = 0;
+	int hits = 0;
+	int misses = 0;
+};
+
+static QuakeToRMLCache quakeToRMLCache;
+static bool quakeToRMLCacheDisabled = false;
+
+void Rocket_ClearQuakeToRMLCache()
+{
+	quakeToRMLCache.entries.clear();
+	quakeToRMLCache.index.clear();
+}
+
+Rml::String Rocket_QuakeToRML( const char *in, int parseFlags = 0 )
+{
+	QuakeToRMLCache &cache = quakeToRMLCache;
+	size_t length = strcspn( in, "^<>&\n[" );
+
+	// nothing to convert or escape
+	if ( !in[ length ] )
+	{
+		cache.plain++;
+		return Rml::String( in, length );
+	}
+
+	length += strlen( in + length );
+
+	if ( quakeToRMLCacheDisabled || length > QUAKE_TO_RML_CACHE_MAX_LENGTH )
+	{
+		return Rocket_ParseQuakeToRML( in, parseFlags );
+	}
+
+	std::string key;
+	key.reserve( length + 1 );
+	key.push_back( static_cast<char>( '0' + parseFlags ) );
+	key.append( in, length );
+
+	auto it = cache.index.find( key );
+
+	if ( it != cache.index.end() )
+	{
+		cache.entries.splice( cache.entries.begin(), cache.entries, it->second );
+		cache.hits++;
+		return it->second->second;
+	}
+
+	cache.misses++;
+
+	if ( cache.entries.size() >= QUAKE_TO_RML_CACHE_SIZE )
+	{
+		cache.index.erase( cache.entries.back().first );
+		cache.entries.pop_back();
+	}
+
+	cache.entries.emplace_front( key, Rocket_ParseQuakeToRML( in, parseFlags ) );
+	cache.index.emplace( std::move( key ), cache.entries.begin() );
+
+	return cache.entries.front().second;
+}
+
+/*
+ * Converts the player names, center print and vote strings currently known
+ * a number of times, with and without the cache.
+ */
+void Rocket_QuakeToRMLBenchmark_f()
+{
+	std::vector<std::string> inputs;
+	int iterations = 1000;
+
+	if ( trap_Argc() > 1 )
+	{
+		iterations = std::max( 1, atoi( CG_Argv( 1 ) ) );
+	}
+
+	for ( int i = 0; i < MAX_CLIENTS; i++ )
+	{
+		if ( cgs.clientinfo[ i ].infoValid )
+		{
+			inputs.emplace_back( cgs.clientinfo[ i ].name );
+		}
+	}
+
+	for ( int team = 0; team < NUM_TEAMS; team++ )
+	{
+		inputs.emplace_back( cgs.voteString[ team ] );
+		inputs.emplace_back( cgs.voteCaller[ team ] );
+	}
+
+	inputs.emplace_back( cg.centerPrint );
+	inputs.emplace_back( CG_ConfigString( CS_MESSAGE ) );
+
+	for ( int pass = 0; pass < 2; pass++ )
+	{
+		size_t total = 0;
+		int startTime;
+
+		quakeToRMLCacheDisabled = ( pass == 0 );
+		quakeToRMLCache.hits = quakeToRMLCache.misses = quakeToRMLCache.plain = 0;
+		startTime = trap_Milliseconds();
+
+		for ( int i = 0; i < iterations; i++ )
+		{
+			for ( const std::string &input : inputs )
+			{
+				total += Rocket_QuakeToRML( input.c_str(), RP_EMOTICONS ).size();
+			}
+		}
+
+		Log::Notice( "%s: %d conversions of %d strings in %d msec (%d plain, %d hits, %d misses, %d bytes out)",
+		             pass == 0 ? "uncached" : "cached", iterations * static_cast<int>( inputs.size() ),
+		             static_cast<int>( inputs.size() ), trap_Milliseconds() - startTime,
+		             quakeToRMLCache.plain, quakeToRMLCache.hits, quakeToRMLCache.misses, static_cast<int>( total ) );
+	}
+
+	quakeToRMLCacheDisabled = false;
+}
+
 void Rocket_QuakeToRMLBuffer( const char *in, char *out, int length )
 {
 	Q_strncpyz( out, Rocket_QuakeToRML( in, RP_EMOTICONS ).c_str(), length );
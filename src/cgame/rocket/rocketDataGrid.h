@@ -65,6 +65,14 @@ public:
 
 	void AddRow( const char *table, const char *dataIn )
 	{
+		auto it = staged.find( table );
+
+		if ( it != staged.end() )
+		{
+			it->second.push_back( dataIn );
+			return;
+		}
+
 		data[ table ].push_back( dataIn );
 		NotifyRowAdd( table, data[ table ].size() - 1, 1 );
 	}
@@ -83,13 +91,79 @@ public:
 
 	void ClearTable( const char *table )
 	{
+		staged.erase( table );
 		data.erase( table );
 		NotifyRowChange( table );
 	}
 
+	// Rows added after this are collected instead of shown, until
+	// CommitTables() replaces the table with them
+	void BeginTable( const char *table )
+	{
+		staged[ table ].clear();
+	}
+
+	bool HasStagedTables() const
+	{
+		return !staged.empty();
+	}
+
+	void CommitTables()
+	{
+		for ( auto &it : staged )
+		{
+			CommitTable( it.first, it.second );
+		}
+
+		staged.clear();
+	}
+
 
 private:
+	// Rows are keyed by their contents: the rows both versions of the
+	// table start and end with are left alone, the differing run in the
+	// middle is changed in place and only the difference in length is
+	// inserted or removed. This way a ping update or a player joining
+	// only touches the affected rows of the datagrids.
+	void CommitTable( const Rml::String &table, std::vector<Rml::String> &rows )
+	{
+		std::vector<Rml::String> &current = data[ table ];
+		size_t prefix = 0, suffix = 0;
+
+		while ( prefix < current.size() && prefix < rows.size() && current[ prefix ] == rows[ prefix ] )
+		{
+			prefix++;
+		}
+
+		while ( suffix < current.size() - prefix && suffix < rows.size() - prefix &&
+		        current[ current.size() - 1 - suffix ] == rows[ rows.size() - 1 - suffix ] )
+		{
+			suffix++;
+		}
+
+		int oldCount = current.size() - prefix - suffix;
+		int newCount = rows.size() - prefix - suffix;
+		int changed = std::min( oldCount, newCount );
+
+		current.swap( rows );
+
+		if ( changed > 0 )
+		{
+			NotifyRowChange( table, prefix, changed );
+		}
+
+		if ( newCount > oldCount )
+		{
+			NotifyRowAdd( table, prefix + changed, newCount - oldCount );
+		}
+		else if ( oldCount > newCount )
+		{
+			NotifyRowRemove( table, prefix + changed, oldCount - newCount );
+		}
+	}
+
 	std::map<Rml::String, std::vector<Rml::String> > data;
+	std::map<Rml::String, std::vector<Rml::String> > staged;
 };
 
 #endif
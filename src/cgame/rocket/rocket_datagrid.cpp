@@ -112,3 +112,29 @@ void Rocket_DSClearTable( const char *name, const char *table )
 
 	ds->ClearTable( table );
 }
+
+void Rocket_DSBeginTable( const char *name, const char *table )
+{
+	RocketDataGrid *ds = FindDataSource( name );
+
+	if ( !ds )
+	{
+		Log::Warn( "Rocket_DSBeginTable: data source %s does not exist.\n", name );
+		return;
+	}
+
+	ds->BeginTable( table );
+}
+
+// Show the rows every table started with Rocket_DSBeginTable has been
+// given since, notifying listeners of only the rows which differ
+void Rocket_DSCommitTables()
+{
+	for ( auto &it : dataSourceMap )
+	{
+		if ( it.second->HasStagedTables() )
+		{
+			it.second->CommitTables();
+		}
+	}
+}
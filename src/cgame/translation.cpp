@@ -49,6 +49,36 @@ using namespace tinygettext;
 static std::string gettextbuffer[ 4 ];
 static int num = -1;
 
+static Cvar::Cvar<bool> trans_cache("trans_cache", "Remember translations instead of looking them up every time", Cvar::NONE, true);
+
+/*
+ * Translations are remembered by message until the language changes, so
+ * messages translated every frame don't go through the dictionary again.
+ * The cache stops growing at TRANS_CACHE_MAX entries so that dynamic
+ * messages can't take up all the memory; after that they are translated
+ * into the buffers above like before. Trans_Gettext additionally keeps
+ * the entry each message pointer last resolved to, so translating a
+ * string literal again costs a string comparison rather than a lookup.
+ */
+#define TRANS_CACHE_MAX 4096
+#define TRANS_LITERAL_CACHE_SIZE 1021
+
+using transCache_t = std::unordered_map<std::string, std::string>;
+
+struct transLiteral_t
+{
+	const char                    *msgid;
+	int                           generation;
+	const transCache_t::value_type *entry;
+};
+
+static transCache_t   transCache;
+static transLiteral_t transLiterals[ TRANS_LITERAL_CACHE_SIZE ];
+static int            transGeneration = 1;
+
+static int transLookups = 0;
+static int transLookupsSaved = 0;
+
 // Should be ROM but that doesn't work in gamelogic
 static Cvar::Cvar<std::string> trans_encodings("trans_encodings", "Supported values for 'language' cvar", Cvar::NONE, "");
 static Cvar::Cvar<std::string> trans_languages("trans_languages", "Supported languages (human-readable)", Cvar::NONE, "");
@@ -250,6 +280,11 @@ static void Trans_SetLanguage( const char* lang )
 
 	trans_manager.set_language( bestLang );
 
+	transCache.clear();
+	transGeneration++;
+	transLookups = 0;
+	transLookupsSaved = 0;
+
 	LOG.Notice( "Set language to %s" , bestLang.get_name().c_str() );
 }
 
@@ -297,6 +332,47 @@ void Trans_Init()
 	Trans_SetLanguage( Cvar::GetValue( "language" ).c_str() );
 }
 
+/*
+====================
+Trans_Remember
+
+Stores a translation in the cache, or in one of the buffers if the
+cache is full or disabled
+====================
+*/
+
+static const char *Trans_Remember( std::string key, std::string translation )
+{
+	if ( !trans_cache.Get() || transCache.size() >= TRANS_CACHE_MAX )
+	{
+		num = ( num + 1 ) & 3;
+		gettextbuffer[ num ] = std::move( translation );
+		return gettextbuffer[ num ].c_str();
+	}
+
+	return transCache.emplace( std::move( key ), std::move( translation ) ).first->second.c_str();
+}
+
+static const char *Trans_Recall( const std::string &key )
+{
+	transLookups++;
+
+	if ( !trans_cache.Get() )
+	{
+		return nullptr;
+	}
+
+	auto it = transCache.find( key );
+
+	if ( it == transCache.end() )
+	{
+		return nullptr;
+	}
+
+	transLookupsSaved++;
+	return it->second.c_str();
+}
+
 const char* Trans_Gettext( const char *msgid )
 {
 	LOG.Debug( "translate[_]: %s", msgid );
@@ -305,9 +381,46 @@ const char* Trans_Gettext( const char *msgid )
 		return msgid;
 	}
 
-	num = ( num + 1 ) & 3;
-	gettextbuffer[ num ] = trans_manager.get_dictionary().translate( msgid );
-	return gettextbuffer[ num ].c_str();
+	if ( !trans_cache.Get() )
+	{
+		transLookups++;
+		return Trans_Remember( msgid, trans_manager.get_dictionary().translate( msgid ) );
+	}
+
+	transLiteral_t &literal = transLiterals[ ( uintptr_t ) msgid % TRANS_LITERAL_CACHE_SIZE ];
+
+	// the pointer may be a buffer which now holds something else
+	if ( literal.msgid == msgid && literal.generation == transGeneration &&
+	     !strcmp( msgid, literal.entry->first.c_str() ) )
+	{
+		transLookups++;
+		transLookupsSaved++;
+		return literal.entry->second.c_str();
+	}
+
+	std::string key = msgid;
+	auto it = transCache.find( key );
+
+	transLookups++;
+
+	if ( it != transCache.end() )
+	{
+		transLookupsSaved++;
+	}
+	else if ( transCache.size() < TRANS_CACHE_MAX )
+	{
+		it = transCache.emplace( key, trans_manager.get_dictionary().translate( key ) ).first;
+	}
+	else
+	{
+		return Trans_Remember( key, trans_manager.get_dictionary().translate( msgid ) );
+	}
+
+	literal.msgid = msgid;
+	literal.generation = transGeneration;
+	literal.entry = &*it;
+
+	return it->second.c_str();
 }
 
 const char* Trans_Pgettext( const char *ctxt, const char *msgid )
@@ -318,9 +431,16 @@ const char* Trans_Pgettext( const char *ctxt, const char *msgid )
 		return msgid;
 	}
 
-	num = ( num + 1 ) & 3;
-	gettextbuffer[ num ] = trans_manager.get_dictionary().translate_ctxt( ctxt, msgid );
-	return gettextbuffer[ num ].c_str();
+	// gettext separates the context from the message with EOT
+	std::string key = Str::Format( "%s\004%s", ctxt, msgid );
+	const char *translated = Trans_Recall( key );
+
+	if ( translated )
+	{
+		return translated;
+	}
+
+	return Trans_Remember( std::move( key ), trans_manager.get_dictionary().translate_ctxt( ctxt, msgid ) );
 }
 
 const char* Trans_GettextPlural( const char *msgid, const char *msgid_plural, int number )
@@ -341,7 +461,19 @@ const char* Trans_GettextPlural( const char *msgid, const char *msgid_plural, in
 		return nullptr;
 	}
 
-	num = ( num + 1 ) & 3;
-	gettextbuffer[ num ] = trans_manager.get_dictionary().translate_plural( msgid, msgid_plural, number );
-	return gettextbuffer[ num ].c_str();
+	std::string key = Str::Format( "\005%s\004%s\004%d", msgid, msgid_plural, number );
+	const char *translated = Trans_Recall( key );
+
+	if ( translated )
+	{
+		return translated;
+	}
+
+	return Trans_Remember( std::move( key ), trans_manager.get_dictionary().translate_plural( msgid, msgid_plural, number ) );
+}
+
+void Trans_Stats_f()
+{
+	Log::Notice( "%d translations cached, %d of %d lookups saved since the language was set",
+	             ( int ) transCache.size(), transLookupsSaved, transLookups );
 }
@@ -2236,6 +2236,7 @@ void G_LayoutSave( const char *name )
 	}
 
 	Com_sprintf( fileName, sizeof( fileName ), "layouts/%s/%s.dat", map, name );
+	G_MapLayoutsChanged( map );
 
 	len = trap_FS_FOpenFile( fileName, &f, fsMode_t::FS_WRITE );
 
@@ -2278,59 +2279,37 @@ void G_LayoutSave( const char *name )
 
 int G_LayoutList( const char *map, char *list, int len )
 {
-	// up to 128 single character layout names could fit in layouts
-	char fileList[( MAX_CVAR_VALUE_STRING / 2 ) * 5 ] = { "" };
-	char layouts[ MAX_CVAR_VALUE_STRING ] = { "" };
-	int  numFiles, i, fileLen = 0, listLen;
-	int  count = 0;
-	char *filePtr;
+	const std::vector<std::string> &mapLayouts = G_MapLayouts( map );
+	std::string layouts = S_BUILTIN_LAYOUT " ";
+	int         count = 0;
 
-	Q_strcat( layouts, sizeof( layouts ), S_BUILTIN_LAYOUT " " );
-	numFiles = trap_FS_GetFileList( va( "layouts/%s", map ), ".dat",
-	                                fileList, sizeof( fileList ) );
-	filePtr = fileList;
-
-	for ( i = 0; i < numFiles; i++, filePtr += fileLen + 1 )
+	for ( const std::string &layout : mapLayouts )
 	{
-		fileLen = strlen( filePtr );
-		listLen = strlen( layouts );
-
-		if ( fileLen < 5 )
-		{
-			continue;
-		}
-
 		// list is full, stop trying to add to it
-		if ( ( listLen + fileLen ) >= (int) sizeof( layouts ) )
+		if ( layouts.size() + layout.size() + 1 >= (size_t) len )
 		{
 			break;
 		}
 
-		Q_strcat( layouts,  sizeof( layouts ), filePtr );
-		listLen = strlen( layouts );
-
-		ASSERT_GE(listLen, 4);
-		// strip extension and add space delimiter
-		layouts[ listLen - 4 ] = ' ';
-		layouts[ listLen - 3 ] = '\0';
+		layouts += layout;
+		layouts += ' ';
 		count++;
 	}
 
-	if ( count != numFiles )
+	if ( count != (int) mapLayouts.size() )
 	{
 		Log::Warn( "layout list was truncated to %d "
 		          "layouts, but %d layout files exist in layouts/%s/.",
-		          count, numFiles, map );
+		          count, (int) mapLayouts.size(), map );
 	}
 
-	Q_strncpyz( list, layouts, len );
+	Q_strncpyz( list, layouts.c_str(), len );
 	return count + 1;
 }
 
 bool G_LayoutExists( Str::StringRef map, Str::StringRef layout )
 {
-	std::string path = Str::Format( "layouts/%s/%s.dat", map, layout );
-	return FS::PakPath::FileExists( path ) || FS::HomePath::FileExists( path );
+	return G_MapLayoutExists( map, layout );
 }
 
 void G_LayoutSelect()
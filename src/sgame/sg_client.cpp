@@ -1856,6 +1856,7 @@ void ClientDisconnect( int clientNum )
 	G_LeaveTeam( ent );
 	G_namelog_disconnect( ent->client );
 	G_Vote( ent, TEAM_NONE, false );
+	G_ResetClientCommandBudgets( clientNum );
 
 	// stop any following clients
 	for ( i = 0; i < level.maxclients; i++ )
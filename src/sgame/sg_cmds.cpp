@@ -48,6 +48,15 @@ Cvar::Range<Cvar::Cvar<int>> g_killDelay(
 		Cvar::NONE,
 		20, 0, 120 );
 
+static Cvar::Cvar<bool> g_commandCPUBudget(
+		"g_commandCPUBudget",
+		"refuse expensive commands from clients that spend too much server time in them",
+		Cvar::NONE, true );
+static Cvar::Cvar<int> g_commandCPURecovery(
+		"g_commandCPURecovery",
+		"milliseconds of command budget a client recovers per second",
+		Cvar::NONE, 10 );
+
 /*
 ==================
 G_SanitiseString
@@ -1091,7 +1100,85 @@ static void Cmd_Team_f( gentity_t *ent )
 
 /*
 ==================
-G_Say
+G_ChatCommand
+
+Formats the server command that delivers a chat message
+==================
+*/
+static const char *G_ChatCommand( gentity_t *ent, saymode_t mode, const char *message )
+{
+	if ( mode == SAY_ALL_ADMIN )
+	{
+		return va( "achat %s %d %s", G_quoted_admin_name( ent ), mode, Quote( message ) );
+	}
+
+	return va( "chat %d %d %s", ent ? ent->num() : -1, mode, Quote( message ) );
+}
+
+/*
+==================
+G_SendChat
+
+Formats a chat message once and sends it to every recipient
+==================
+*/
+static void G_SendChat( gentity_t *ent, saymode_t mode, const char *message, const clientList_t *recipients )
+{
+	const char *cmd = G_ChatCommand( ent, mode, message );
+
+	for ( int i = 0; i < level.maxclients; i++ )
+	{
+		if ( Com_ClientListContains( recipients, i ) )
+		{
+			trap_SendServerCommand( i, cmd );
+		}
+	}
+}
+
+/*
+==================
+G_ChatRecipients
+
+Clients that read a message of the given mode from ent, derived from the
+per-team lists of connected clients
+==================
+*/
+static clientList_t G_ChatRecipients( gentity_t *ent, saymode_t mode )
+{
+	clientList_t recipients;
+	team_t       team = G_Team( ent );
+	bool         teamOnly = ent && ( mode == SAY_TEAM || mode == SAY_AREA || mode == SAY_TPRIVMSG );
+
+	memset( &recipients, 0, sizeof( recipients ) );
+
+	for ( int i = 0; i < level.maxclients; i++ )
+	{
+		if ( Com_ClientListContains( &level.team[ team ].chatRecipients, i ) )
+		{
+			Com_ClientListAdd( &recipients, i );
+		}
+		else if ( Com_ClientListContains( &level.team[ TEAM_NONE ].chatRecipients, i ) )
+		{
+			// specs with ADMF_SPEC_ALLCHAT flag can see team chat
+			if ( !teamOnly || mode == SAY_TPRIVMSG ||
+			     G_admin_permission( &g_entities[ i ], ADMF_SPEC_ALLCHAT ) )
+			{
+				Com_ClientListAdd( &recipients, i );
+			}
+		}
+		else if ( !teamOnly && ( Com_ClientListContains( &level.team[ TEAM_ALIENS ].chatRecipients, i ) ||
+		                         Com_ClientListContains( &level.team[ TEAM_HUMANS ].chatRecipients, i ) ) )
+		{
+			Com_ClientListAdd( &recipients, i );
+		}
+	}
+
+	return recipients;
+}
+
+/*
+==================
+G_SayTo
 ==================
 */
 static bool G_SayTo( gentity_t *ent, gentity_t *other, saymode_t mode, const char *message )
@@ -1139,27 +1226,18 @@ static bool G_SayTo( gentity_t *ent, gentity_t *other, saymode_t mode, const cha
 		}
 	}
 
-	if ( mode == SAY_ALL_ADMIN )
-	{
-		trap_SendServerCommand( other->num(), va( "achat %s %d %s",
-		                        G_quoted_admin_name( ent ),
-		                        mode, Quote( message ) ) );
-	}
-	else
-	{
-		trap_SendServerCommand( other->num(), va( "chat %d %d %s",
-		                        ent ? ent->num() : -1,
-		                        mode, Quote( message ) ) );
-	}
+	trap_SendServerCommand( other->num(), G_ChatCommand( ent, mode, message ) );
 
 	return true;
 }
 
+/*
+==================
+G_Say
+==================
+*/
 void G_Say( gentity_t *ent, saymode_t mode, const char *chatText )
 {
-	int       j;
-	gentity_t *other;
-
 	// check if subject to negative flags
 	if ( ( ent ) && ( G_admin_permission( ent, ADMF_NO_GLOBALCHAT )
 		 && ( mode == SAY_ALL || mode == SAY_AREA
@@ -1228,11 +1306,47 @@ void G_Say( gentity_t *ent, saymode_t mode, const char *chatText )
 	}
 
 	// send it to all the appropriate clients
-	for ( j = 0; j < level.maxclients; j++ )
+	clientList_t recipients = G_ChatRecipients( ent, mode );
+	G_SendChat( ent, mode, chatText, &recipients );
+}
+
+/*
+==================
+G_SayArea
+
+Sends a message to the sender's team mates within g_sayAreaRange and to
+spectators with the ADMF_SPEC_ALLCHAT flag
+==================
+*/
+static void G_SayArea( gentity_t *ent, saymode_t mode, const char *msg )
+{
+	vec3_t       range, mins, maxs;
+	clientList_t recipients;
+	team_t       team = G_Team( ent );
+
+	memset( &recipients, 0, sizeof( recipients ) );
+
+	VectorSet( range, g_sayAreaRange.Get(), g_sayAreaRange.Get(), g_sayAreaRange.Get() );
+	VectorAdd( ent->s.origin, range, maxs );
+	VectorSubtract( ent->s.origin, range, mins );
+
+	for ( int i = 0; i < level.maxclients; i++ )
 	{
-		other = &g_entities[ j ];
-		G_SayTo( ent, other, mode, chatText );
+		gentity_t *other = &g_entities[ i ];
+
+		if ( Com_ClientListContains( &level.team[ TEAM_NONE ].chatRecipients, i ) &&
+		     G_admin_permission( other, ADMF_SPEC_ALLCHAT ) )
+		{
+			Com_ClientListAdd( &recipients, i );
+		}
+		else if ( Com_ClientListContains( &level.team[ team ].chatRecipients, i ) &&
+		          other->r.linked && BoundsIntersect( mins, maxs, other->r.absmin, other->r.absmax ) )
+		{
+			Com_ClientListAdd( &recipients, i );
+		}
 	}
+
+	G_SendChat( ent, mode, msg, &recipients );
 }
 
 /*
@@ -1242,11 +1356,7 @@ Cmd_SayArea_f
 */
 static void Cmd_SayArea_f( gentity_t *ent )
 {
-	int    entityList[ MAX_GENTITIES ];
-	int    num, i;
-	vec3_t range = { 1000.0f, 1000.0f, 1000.0f };
-	vec3_t mins, maxs;
-	char   *msg;
+	char *msg;
 
 	if ( trap_Argc() < 2 )
 	{
@@ -1256,42 +1366,15 @@ static void Cmd_SayArea_f( gentity_t *ent )
 
 	msg = ConcatArgs( 1 );
 
-	for ( i = 0; i < 3; i++ )
-	{
-		range[ i ] = g_sayAreaRange.Get();
-	}
-
 	G_LogPrintf( "SayArea: %d \"%s^*\": ^4%s",
 	             ent->num(), ent->client->pers.netname, msg );
 
-	VectorAdd( ent->s.origin, range, maxs );
-	VectorSubtract( ent->s.origin, range, mins );
-
-	num = trap_EntitiesInBox( mins, maxs, entityList, MAX_GENTITIES );
-
-	for ( i = 0; i < num; i++ )
-	{
-		G_SayTo( ent, &g_entities[ entityList[ i ] ], SAY_AREA, msg );
-	}
-
-	//Send to ADMF_SPEC_ALLCHAT candidates
-	for ( i = 0; i < level.maxclients; i++ )
-	{
-		if ( g_clients[ i ].pers.team == TEAM_NONE &&
-		     G_admin_permission( &g_entities[ i ], ADMF_SPEC_ALLCHAT ) )
-		{
-			G_SayTo( ent, &g_entities[ i ], SAY_AREA, msg );
-		}
-	}
+	G_SayArea( ent, SAY_AREA, msg );
 }
 
 static void Cmd_SayAreaTeam_f( gentity_t *ent )
 {
-	int    entityList[ MAX_GENTITIES ];
-	int    num, i;
-	vec3_t range = { 1000.0f, 1000.0f, 1000.0f };
-	vec3_t mins, maxs;
-	char   *msg;
+	char *msg;
 
 	if ( trap_Argc() < 2 )
 	{
@@ -1301,37 +1384,10 @@ static void Cmd_SayAreaTeam_f( gentity_t *ent )
 
 	msg = ConcatArgs( 1 );
 
-	for ( i = 0; i < 3; i++ )
-	{
-		range[ i ] = g_sayAreaRange.Get();
-	}
-
 	G_LogPrintf( "SayAreaTeam: %d \"%s^*\": ^4%s",
 	             ent->num(), ent->client->pers.netname, msg );
 
-	VectorAdd( ent->s.origin, range, maxs );
-	VectorSubtract( ent->s.origin, range, mins );
-
-	num = trap_EntitiesInBox( mins, maxs, entityList, MAX_GENTITIES );
-
-	for ( i = 0; i < num; i++ )
-	{
-		if ( g_entities[ entityList[ i ] ].client &&
-			ent->client->pers.team == g_entities[ entityList[ i ] ].client->pers.team )
-		{
-			G_SayTo( ent, &g_entities[ entityList[ i ] ], SAY_AREA_TEAM, msg );
-		}
-	}
-
-	//Send to ADMF_SPEC_ALLCHAT candidates
-	for ( i = 0; i < level.maxclients; i++ )
-	{
-		if ( g_entities[ i ].client->pers.team == TEAM_NONE &&
-		     G_admin_permission( &g_entities[ i ], ADMF_SPEC_ALLCHAT ) )
-		{
-			G_SayTo( ent, &g_entities[ i ], SAY_AREA_TEAM, msg );
-		}
-	}
+	G_SayArea( ent, SAY_AREA_TEAM, msg );
 }
 
 
@@ -1483,7 +1539,7 @@ static void Cmd_VSay_f( gentity_t *ent )
 	}
 
 	trap_Argv( 1, voiceCmd, sizeof( voiceCmd ) );
-	cmd = BG_VoiceCmdFind( voice->cmds, voiceCmd, &cmdNum );
+	cmd = BG_VoiceCmdFind( voice, voiceCmd, &cmdNum );
 
 	if ( !cmd )
 	{
@@ -1501,7 +1557,7 @@ static void Cmd_VSay_f( gentity_t *ent )
 		weapon = BG_PrimaryWeapon( ent->client->ps.stats );
 	}
 
-	track = BG_VoiceTrackFind( cmd->tracks, ent->client->pers.team,
+	track = BG_VoiceTrackFind( cmd, ent->client->pers.team,
 	                           ent->client->pers.classSelection, weapon, ( int ) ent->client->voiceEnthusiasm,
 	                           &trackNum );
 
@@ -1667,6 +1723,30 @@ static bool botFillVoteParseArg( int& argnum, char *arg )
 	}
 }
 
+/*
+==================
+G_CompleteVoteMap
+
+Replaces a map name that is not found with the only map it is a prefix of
+==================
+*/
+static void G_CompleteVoteMap( char *arg, size_t size )
+{
+	std::vector<const std::string *> maps;
+
+	if ( !*arg || G_MapExists( arg ) )
+	{
+		return;
+	}
+
+	G_MapsWithPrefix( arg, maps );
+
+	if ( maps.size() == 1 )
+	{
+		Q_strncpyz( arg, maps[ 0 ]->c_str(), size );
+	}
+}
+
 /*
 ==================
 Cmd_CallVote_f
@@ -2088,6 +2168,8 @@ static void Cmd_CallVote_f( gentity_t *ent )
 		break;
 
 	case VOTE_MAP:
+		G_CompleteVoteMap( arg, sizeof( arg ) );
+
 		if ( !G_MapExists( arg ) )
 		{
 			trap_SendServerCommand( ent->num(),
@@ -2147,6 +2229,8 @@ static void Cmd_CallVote_f( gentity_t *ent )
 			return;
 		}
 
+		G_CompleteVoteMap( arg, sizeof( arg ) );
+
 		if ( !G_MapExists( arg ) )
 		{
 			trap_SendServerCommand( ent->num(),
@@ -4337,15 +4421,20 @@ static void Cmd_ListMaps_f( gentity_t *ent )
 		}
 	}
 
-	// Legacy paks not included because they aren't allowed by G_MapExists (for votes etc.)
-	static const std::set<std::string> mapNames = FS::GetAvailableMaps(false);
 	std::vector<const std::string*> filteredMapNames;
 
-	for ( const std::string& name : mapNames )
+	// maps starting with the search come from the prefix index, other
+	// matches are only looked for when there are none
+	G_MapsWithPrefix( search, filteredMapNames );
+
+	if ( filteredMapNames.empty() )
 	{
-		if ( strstr( name.c_str(), search ) )
+		for ( const std::string& name : G_MapCatalogue() )
 		{
-			filteredMapNames.push_back( &name );
+			if ( strstr( name.c_str(), search ) )
+			{
+				filteredMapNames.push_back( &name );
+			}
 		}
 	}
 
@@ -4783,8 +4872,8 @@ int G_FloodLimited( gentity_t *ent )
 	return ms;
 }
 
-// commands must be in alphabetical order!
-// keep the list synchronized with the list in cg_consolecmds for completion.
+// keep the list in alphabetical order and synchronized with the list in
+// cg_consolecmds for completion.
 static const commands_t cmds[] =
 {
 	{ "a",               CMD_MESSAGE | CMD_INTERMISSION,      Cmd_AdminMessage_f     },
@@ -4844,6 +4933,172 @@ static const commands_t cmds[] =
 };
 static const size_t numCmds = ARRAY_LEN( cmds );
 
+/*
+ * Commands are found through a case insensitive hash table built from
+ * cmds[] on first use.
+ *
+ * The time spent in each handler is accounted per client and per command in
+ * a leaky bucket that drains at g_commandCPURecovery. The commands listed in
+ * commandBudgets are refused while their bucket holds more than their own
+ * budget, so a client cannot spend server frames on commands that are cheap
+ * to send but expensive to handle. Every other command is only accounted.
+ */
+#define COMMAND_HASH_SIZE 128 // must be a power of two larger than numCmds
+
+// milliseconds of server time a client may have in the bucket of a command
+static const struct
+{
+	const char *cmdName;
+	int        budget;
+} commandBudgets[] =
+{
+	{ "callteamvote", 50 },
+	{ "callvote",     50 },
+	{ "listmaps",     50 },
+	{ "listrotation", 20 },
+	{ "maplog",       20 },
+	{ "score",        20 },
+	{ "teamstatus",   20 },
+};
+
+struct commandUsage_t
+{
+	int spent; // milliseconds in the bucket
+	int lastTime; // level.time of the last drain
+};
+
+struct commandStats_t
+{
+	int     calls;
+	int     refused;
+	int64_t totalTime; // milliseconds
+	int     maxTime;
+};
+
+static int            commandHash[ COMMAND_HASH_SIZE ]; // index in cmds + 1, 0 if empty
+static int            commandBudget[ ARRAY_LEN( cmds ) ]; // 0 if never refused
+static commandUsage_t commandUsage[ MAX_CLIENTS ][ ARRAY_LEN( cmds ) ];
+static commandStats_t commandStats[ ARRAY_LEN( cmds ) ];
+
+static const commands_t *G_FindClientCommand( const char *name )
+{
+	static bool initialized = false;
+
+	if ( !initialized )
+	{
+		static_assert( ARRAY_LEN( cmds ) < COMMAND_HASH_SIZE, "COMMAND_HASH_SIZE is too small" );
+
+		for ( size_t i = 0; i < numCmds; i++ )
+		{
+			unsigned slot = BG_HashNameLower( cmds[ i ].cmdName ) & ( COMMAND_HASH_SIZE - 1 );
+
+			while ( commandHash[ slot ] )
+			{
+				slot = ( slot + 1 ) & ( COMMAND_HASH_SIZE - 1 );
+			}
+
+			commandHash[ slot ] = i + 1;
+		}
+
+		for ( const auto &budget : commandBudgets )
+		{
+			for ( size_t i = 0; i < numCmds; i++ )
+			{
+				if ( !Q_stricmp( cmds[ i ].cmdName, budget.cmdName ) )
+				{
+					commandBudget[ i ] = budget.budget;
+				}
+			}
+		}
+
+		initialized = true;
+	}
+
+	for ( unsigned slot = BG_HashNameLower( name ) & ( COMMAND_HASH_SIZE - 1 ); commandHash[ slot ];
+	      slot = ( slot + 1 ) & ( COMMAND_HASH_SIZE - 1 ) )
+	{
+		const commands_t *command = &cmds[ commandHash[ slot ] - 1 ];
+
+		if ( !Q_stricmp( command->cmdName, name ) )
+		{
+			return command;
+		}
+	}
+
+	return nullptr;
+}
+
+/*
+=================
+G_CommandBudgetExceeded
+
+Drains the client's bucket for the command and checks it against the budget
+=================
+*/
+static bool G_CommandBudgetExceeded( gentity_t *ent, size_t index )
+{
+	commandUsage_t *usage = &commandUsage[ ent->num() ][ index ];
+	int            budget = commandBudget[ index ];
+	int64_t        drained;
+
+	drained = static_cast<int64_t>( level.time - usage->lastTime ) * g_commandCPURecovery.Get() / 1000;
+	usage->spent = std::max<int64_t>( 0, usage->spent - std::max<int64_t>( 0, drained ) );
+	usage->lastTime = level.time;
+
+	if ( !g_commandCPUBudget.Get() || !budget || usage->spent <= budget )
+	{
+		return false;
+	}
+
+	if ( G_admin_permission( ent, ADMF_NOCENSORFLOOD ) )
+	{
+		return false;
+	}
+
+	commandStats[ index ].refused++;
+
+	trap_SendServerCommand( ent->num(), va( "print_tr %s %d", QQ( N_("You are flooding: "
+	                        "please wait $1$s before trying again") ),
+	                        std::max( 1, ( usage->spent - budget ) /
+	                                     std::max( 1, g_commandCPURecovery.Get() ) ) ) );
+	return true;
+}
+
+/*
+=================
+G_ResetClientCommandBudgets
+=================
+*/
+void G_ResetClientCommandBudgets( int clientNum )
+{
+	memset( commandUsage[ clientNum ], 0, sizeof( commandUsage[ clientNum ] ) );
+}
+
+/*
+=================
+G_PrintCommandStats
+=================
+*/
+void G_PrintCommandStats()
+{
+	Log::Notice( "%-16s %8s %8s %10s %8s %8s", "command", "calls", "refused", "total ms", "avg ms", "max ms" );
+
+	for ( size_t i = 0; i < numCmds; i++ )
+	{
+		const commandStats_t *stats = &commandStats[ i ];
+
+		if ( !stats->calls && !stats->refused )
+		{
+			continue;
+		}
+
+		Log::Notice( "%-16s %8d %8d %10d %8.2f %8d", cmds[ i ].cmdName, stats->calls, stats->refused,
+		             static_cast<int>( stats->totalTime ),
+		             stats->calls ? static_cast<double>( stats->totalTime ) / stats->calls : 0.0,
+		             stats->maxTime );
+	}
+}
+
 /*
 =================
 ClientCommand
@@ -4851,9 +5106,10 @@ ClientCommand
 */
 void ClientCommand( int clientNum )
 {
-	gentity_t  *ent;
-	char       cmd[ MAX_TOKEN_CHARS ];
-	commands_t *command;
+	gentity_t        *ent;
+	char             cmd[ MAX_TOKEN_CHARS ];
+	const commands_t *command;
+	size_t           index;
 
 	ent = g_entities + clientNum;
 
@@ -4864,7 +5120,7 @@ void ClientCommand( int clientNum )
 
 	trap_Argv( 0, cmd, sizeof( cmd ) );
 
-	command = (commands_t*) bsearch( cmd, cmds, numCmds, sizeof( cmds[ 0 ] ), cmdcmp );
+	command = G_FindClientCommand( cmd );
 
 	if ( !command )
 	{
@@ -4939,7 +5195,23 @@ void ClientCommand( int clientNum )
 		return;
 	}
 
+	index = command - cmds;
+
+	if ( G_CommandBudgetExceeded( ent, index ) )
+	{
+		return;
+	}
+
+	int start = Sys::Milliseconds();
+
 	command->cmdHandler( ent );
+
+	int elapsed = Sys::Milliseconds() - start;
+
+	commandUsage[ clientNum ][ index ].spent += elapsed;
+	commandStats[ index ].calls++;
+	commandStats[ index ].totalTime += elapsed;
+	commandStats[ index ].maxTime = std::max( commandStats[ index ].maxTime, elapsed );
 }
 
 void G_UnEscapeString( const char *in, char *out, int len )
@@ -1172,6 +1172,7 @@ void CalculateRanks()
 		level.team[ team ].numPlayers      = 0;
 		level.team[ team ].numBots         = 0;
 		level.team[ team ].numAliveClients = 0;
+		memset( &level.team[ team ].chatRecipients, 0, sizeof( clientList_t ) );
 	}
 
 	for ( clientNum = 0; clientNum < level.maxclients; clientNum++ )
@@ -1207,6 +1208,8 @@ void CalculateRanks()
 				continue;
 			}
 
+			Com_ClientListAdd( &level.team[ team ].chatRecipients, clientNum );
+
 			// clients on a team are "playing"
 			if ( team != TEAM_NONE )
 			{
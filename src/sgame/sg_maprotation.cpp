@@ -26,6 +26,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 // sg_maprotation.c -- the map rotation system
 
+#include "common/FileSystem.h"
 #include "sg_local.h"
 
 #define MAX_MAP_ROTATIONS     64
@@ -117,6 +118,171 @@ static mapRotations_t mapRotations;
 static int            G_CurrentNodeIndex( int rotation );
 static int            G_NodeIndexAfter( int currentNode, int rotation );
 
+/*
+ * Map catalogue
+ *
+ * Sorted names of the available maps, and of the layouts of each map once
+ * they have been asked for, so that listmaps, votes, admin commands and
+ * rotation conditions don't query the file system every time. Names that
+ * are not in the catalogue are still looked up, and added when found, so
+ * maps and layouts that appear while the game runs are picked up. Being
+ * sorted, the map list doubles as the prefix index for listmaps and map
+ * votes. It is dropped when the game shuts down, since paks are only
+ * loaded again with the next map.
+ */
+struct mapCatalogue_t
+{
+	bool initialized;
+	std::vector<std::string> maps;
+	std::unordered_map<std::string, std::vector<std::string>> layouts;
+};
+
+static mapCatalogue_t mapCatalogue;
+
+static bool G_SortedContains( const std::vector<std::string> &names, const std::string &name )
+{
+	return std::binary_search( names.begin(), names.end(), name );
+}
+
+static void G_SortedInsert( std::vector<std::string> &names, const std::string &name )
+{
+	auto it = std::lower_bound( names.begin(), names.end(), name );
+
+	if ( it == names.end() || *it != name )
+	{
+		names.insert( it, name );
+	}
+}
+
+/*
+===============
+G_MapCatalogue
+
+Sorted list of the maps that can be played
+===============
+*/
+const std::vector<std::string> &G_MapCatalogue()
+{
+	if ( !mapCatalogue.initialized )
+	{
+		// Legacy paks not included because they aren't allowed by G_MapExists (for votes etc.)
+		std::set<std::string> maps = FS::GetAvailableMaps( false );
+
+		mapCatalogue.maps.assign( maps.begin(), maps.end() );
+		mapCatalogue.initialized = true;
+	}
+
+	return mapCatalogue.maps;
+}
+
+/*
+===============
+G_MapsWithPrefix
+
+Adds the maps whose name starts with prefix, in order
+===============
+*/
+void G_MapsWithPrefix( const std::string &prefix, std::vector<const std::string *> &maps )
+{
+	const std::vector<std::string> &names = G_MapCatalogue();
+
+	for ( auto it = std::lower_bound( names.begin(), names.end(), prefix );
+	      it != names.end() && !it->compare( 0, prefix.size(), prefix ); ++it )
+	{
+		maps.push_back( &*it );
+	}
+}
+
+/*
+===============
+G_ResetMapCatalogue
+
+Forget every cached map and layout
+===============
+*/
+void G_ResetMapCatalogue()
+{
+	mapCatalogue.initialized = false;
+	mapCatalogue.maps.clear();
+	mapCatalogue.layouts.clear();
+}
+
+/*
+===============
+G_MapLayouts
+
+Sorted list of the layouts of a map, not including the builtin one
+===============
+*/
+const std::vector<std::string> &G_MapLayouts( const std::string &map )
+{
+	auto it = mapCatalogue.layouts.find( map );
+
+	if ( it != mapCatalogue.layouts.end() )
+	{
+		return it->second;
+	}
+
+	std::vector<std::string> &layouts = mapCatalogue.layouts[ map ];
+	static char fileList[ 16384 ];
+	char        *filePtr = fileList;
+	int         numFiles;
+
+	numFiles = trap_FS_GetFileList( va( "layouts/%s", map.c_str() ), ".dat", fileList, sizeof( fileList ) );
+
+	for ( int i = 0; i < numFiles; i++ )
+	{
+		size_t fileLen = strlen( filePtr );
+
+		if ( fileLen >= 5 )
+		{
+			// strip extension
+			G_SortedInsert( layouts, std::string( filePtr, fileLen - 4 ) );
+		}
+
+		filePtr += fileLen + 1;
+	}
+
+	return layouts;
+}
+
+/*
+===============
+G_MapLayoutExists
+
+Check if a layout exists for a map
+===============
+*/
+bool G_MapLayoutExists( const std::string &map, const std::string &layout )
+{
+	if ( G_SortedContains( G_MapLayouts( map ), layout ) )
+	{
+		return true;
+	}
+
+	std::string path = Str::Format( "layouts/%s/%s.dat", map, layout );
+
+	if ( FS::PakPath::FileExists( path ) || FS::HomePath::FileExists( path ) )
+	{
+		G_SortedInsert( mapCatalogue.layouts[ map ], layout );
+		return true;
+	}
+
+	return false;
+}
+
+/*
+===============
+G_MapLayoutsChanged
+
+Forget the cached layouts of a map, after one was written
+===============
+*/
+void G_MapLayoutsChanged( const std::string &map )
+{
+	mapCatalogue.layouts.erase( map );
+}
+
 /*
 ===============
 G_MapExists
@@ -126,9 +292,22 @@ Check if a map exists
 */
 bool G_MapExists( const char *name )
 {
+	std::vector<std::string> &maps = mapCatalogue.maps;
+
+	if ( G_SortedContains( G_MapCatalogue(), name ) )
+	{
+		return true;
+	}
+
 	// Due to filesystem changes, checking whether "maps/$name.bsp" exists in the
 	// VFS is no longer the correct way to check whether a map exists
-	return trap_FindPak( va( "map-%s", name ) );
+	if ( trap_FindPak( va( "map-%s", name ) ) )
+	{
+		G_SortedInsert( maps, name );
+		return true;
+	}
+
+	return false;
 }
 
 /*
@@ -1543,4 +1722,7 @@ void G_ShutdownMapRotations()
 	}
 
 	memset( &mapRotations, 0, sizeof( mapRotations ) );
+
+	// the paks can change before the next map
+	G_ResetMapCatalogue();
 }
@@ -170,6 +170,8 @@ bool          G_ScheduleSpawn( gclient_t *client, class_t class_, weapon_t human
 bool          G_AlienEvolve( gentity_t *ent, class_t newClass, bool report, bool dryRun );
 void              ScoreboardMessage( gentity_t *client );
 void              ClientCommand( int clientNum );
+void              G_ResetClientCommandBudgets( int clientNum );
+void              G_PrintCommandStats();
 void              G_ClearRotationStack();
 void              G_MapLog_NewMap();
 void              G_MapLog_Result( char result );
@@ -240,6 +242,12 @@ bool          G_MapRotationActive();
 void              G_InitMapRotations();
 void              G_ShutdownMapRotations();
 bool          G_MapExists( const char *name );
+const std::vector<std::string> &G_MapCatalogue();
+void          G_MapsWithPrefix( const std::string &prefix, std::vector<const std::string *> &maps );
+void          G_ResetMapCatalogue();
+const std::vector<std::string> &G_MapLayouts( const std::string &map );
+bool          G_MapLayoutExists( const std::string &map, const std::string &layout );
+void          G_MapLayoutsChanged( const std::string &map );
 
 // sg_missile.c
 void              G_ExplodeMissile( gentity_t *ent );
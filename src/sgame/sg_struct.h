@@ -824,6 +824,7 @@ struct level_locals_t
 		float            averageNumBots;
 		int              numSamples;
 		int              numAliveClients;
+		clientList_t     chatRecipients; // connected clients, maintained by CalculateRanks
 		float            totalBudget; // Read access always rounds towards zero.
 		int              spentBudget;
 		int              queuedBudget;
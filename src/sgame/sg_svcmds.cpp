@@ -693,6 +693,7 @@ static const struct svcmd
 	{ "alienWin",           false, Svcmd_TeamWin_f              },
 	{ "asay",               true,  Svcmd_MessageWrapper         },
 	{ "chat",               true,  Svcmd_MessageWrapper         },
+	{ "commandStats",       false, G_PrintCommandStats          },
 	{ "cp",                 false, Svcmd_CenterPrint_f          },
 	{ "dumpuser",           false, Svcmd_DumpUser_f             },
 	{ "eject",              false, Svcmd_EjectClient_f          },
@@ -36,6 +36,135 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 // delayed translation - these strings may be passed to Trans_Gettext() later
 #define N_(x) x
 
+/*
+================
+Name indexes
+
+The ByName lookups go through case-insensitive hash tables built on
+first use. Each slot holds an index into the registry plus one, with 0
+marking an empty slot, and collisions probe the following slots. Names
+are inserted in registry order, so the first of several entries with the
+same name is the one found, just like a linear scan.
+
+While the configs load, the registries are still being filled in and a
+parser may look up names already read, so until config_loaded is set the
+lookups scan the registries instead and no index is built.
+================
+*/
+
+// set once every registry is complete
+bool config_loaded = false;
+
+// must be a power of two and more than twice the largest registry
+#define NAME_INDEX_SIZE 256
+
+struct nameIndex_t
+{
+	bool  built;
+	short slots[ NAME_INDEX_SIZE ];
+};
+
+/*
+================
+BG_HashBytes
+================
+*/
+uint32_t BG_HashBytes( uint32_t hash, const void *data, size_t size )
+{
+	const byte *bytes = static_cast<const byte *>( data );
+
+	for ( size_t i = 0; i < size; i++ )
+	{
+		hash = ( hash ^ bytes[ i ] ) * 16777619u;
+	}
+
+	return hash;
+}
+
+/*
+================
+BG_HashNameLower
+
+Hashes a name case insensitively
+================
+*/
+uint32_t BG_HashNameLower( const char *name )
+{
+	uint32_t hash = BG_HASH_INIT;
+
+	for ( ; *name; name++ )
+	{
+		hash = ( hash ^ static_cast<unsigned char>( Str::ctolower( *name ) ) ) * 16777619u;
+	}
+
+	return hash;
+}
+
+/*
+================
+BG_FindName
+
+Returns the index of the first item whose name matches, or -1
+================
+*/
+template<typename T, typename S>
+static int BG_FindName( nameIndex_t &index, const T *items, size_t count, S T::*name, const char *key )
+{
+	unsigned slot;
+
+	if ( !config_loaded )
+	{
+		for ( size_t i = 0; key && i < count; i++ )
+		{
+			if ( items[ i ].*name && !Q_stricmp( items[ i ].*name, key ) )
+			{
+				return i;
+			}
+		}
+
+		return -1;
+	}
+
+	if ( !index.built )
+	{
+		memset( index.slots, 0, sizeof( index.slots ) );
+
+		for ( size_t i = 0; i < count; i++ )
+		{
+			if ( !( items[ i ].*name ) )
+			{
+				continue;
+			}
+
+			for ( slot = BG_HashNameLower( items[ i ].*name ); index.slots[ slot & ( NAME_INDEX_SIZE - 1 ) ]; slot++ );
+
+			index.slots[ slot & ( NAME_INDEX_SIZE - 1 ) ] = i + 1;
+		}
+
+		index.built = true;
+	}
+
+	if ( !key )
+	{
+		return -1;
+	}
+
+	for ( slot = BG_HashNameLower( key ); ; slot++ )
+	{
+		int i = index.slots[ slot & ( NAME_INDEX_SIZE - 1 ) ] - 1;
+
+		if ( i < 0 )
+		{
+			return -1;
+		}
+
+		if ( !Q_stricmp( items[ i ].*name, key ) )
+		{
+			return i;
+		}
+	}
+}
+
 struct buildableName_t
 {
 	buildable_t number;
@@ -71,6 +200,9 @@ static buildableAttributes_t bg_buildableList[ ARRAY_LEN( bg_buildableNameList )
 
 static const buildableAttributes_t nullBuildable {};
 
+static nameIndex_t bg_buildableNameIndex;
+static nameIndex_t bg_buildableEntityNameIndex;
+
 /*
 ==============
 BG_BuildableByName
@@ -78,15 +210,10 @@ BG_BuildableByName
 */
 const buildableAttributes_t *BG_BuildableByName( const char *name )
 {
-	for ( unsigned i = 0; i < bg_numBuildables; i++ )
-	{
-		if ( !Q_stricmp( bg_buildableList[ i ].name, name ) )
-		{
-			return &bg_buildableList[ i ];
-		}
-	}
+	int i = BG_FindName( bg_buildableNameIndex, bg_buildableList, bg_numBuildables,
+	                     &buildableAttributes_t::name, name );
 
-	return &nullBuildable;
+	return i >= 0 ? &bg_buildableList[ i ] : &nullBuildable;
 }
 
 /*
@@ -96,15 +223,10 @@ BG_BuildableByEntityName
 */
 const buildableAttributes_t *BG_BuildableByEntityName( const char *name )
 {
-	for ( unsigned i = 0; i < bg_numBuildables; i++ )
-	{
-		if ( !Q_stricmp( bg_buildableList[ i ].entityName, name ) )
-		{
-			return &bg_buildableList[ i ];
-		}
-	}
+	int i = BG_FindName( bg_buildableEntityNameIndex, bg_buildableList, bg_numBuildables,
+	                     &buildableAttributes_t::entityName, name );
 
-	return &nullBuildable;
+	return i >= 0 ? &bg_buildableList[ i ] : &nullBuildable;
 }
 
 /*
@@ -123,7 +245,7 @@ const buildableAttributes_t *BG_Buildable( int buildable )
 BG_InitBuildableAttributes
 ===============
 */
-static void BG_InitBuildableAttributes()
+static void BG_InitBuildableAttributes( bool parse )
 {
 	const buildableName_t *bh;
 	buildableAttributes_t *ba;
@@ -146,7 +268,7 @@ static void BG_InitBuildableAttributes()
 
 		// HACK: Do not parse the repeater. It's there just for Tremulous compatibility.
 		// Since it's not a real building in Unv, skip loading its files.
-		if ( !Q_strnicmp(bh->name, "repeater", sizeof(bh->name) ) )
+		if ( !parse || !Q_strnicmp(bh->name, "repeater", sizeof(bh->name) ) )
 		{
 			continue;
 		}
@@ -192,7 +314,7 @@ void BG_BuildableBoundingBox( int buildable,
 BG_InitBuildableModelConfigs
 ===============
 */
-static void BG_InitBuildableModelConfigs()
+static void BG_InitBuildableModelConfigs( bool parse )
 {
 	int               i;
 	buildableModelConfig_t *bc;
@@ -202,6 +324,11 @@ static void BG_InitBuildableModelConfigs()
 		bc = BG_BuildableModelConfig( i );
 		memset( bc, 0, sizeof( buildableModelConfig_t ) );
 
+		if ( !parse )
+		{
+			continue;
+		}
+
 		BG_ParseBuildableModelFile( va( "configs/buildables/%s.model.cfg",
 		                           BG_Buildable( i )->name ), bc );
 	}
@@ -296,6 +423,9 @@ static classAttributes_t bg_classList[ ARRAY_LEN( bg_classData ) ];
 static const classAttributes_t nullClass {};
 static /*const*/ classModelConfig_t nullClassModelConfig {};
 
+static nameIndex_t bg_classNameIndex;
+static nameIndex_t bg_classModelNameIndex;
+
 /*
 ==============
 BG_ClassByName
@@ -303,18 +433,10 @@ BG_ClassByName
 */
 const classAttributes_t *BG_ClassByName( const char *name )
 {
-	if ( name )
-	{
-		for ( unsigned i = 0; i < bg_numClasses; i++ )
-		{
-			if ( !Q_stricmp( bg_classList[ i ].name, name ) )
-			{
-				return &bg_classList[ i ];
-			}
-		}
-	}
+	int i = BG_FindName( bg_classNameIndex, bg_classList, bg_numClasses,
+	                     &classAttributes_t::name, name );
 
-	return &nullClass;
+	return i >= 0 ? &bg_classList[ i ] : &nullClass;
 }
 
 /*
@@ -337,18 +459,10 @@ BG_ClassModelConfigByName
 */
 classModelConfig_t *BG_ClassModelConfigByName( const char *name )
 {
-	if ( name )
-	{
-		for ( unsigned i = 0; i < bg_numClasses; i++ )
-		{
-			if ( !Q_stricmp( bg_classModelConfigList[ i ].humanName, name ) )
-			{
-				return &bg_classModelConfigList[ i ];
-			}
-		}
-	}
+	int i = BG_FindName( bg_classModelNameIndex, bg_classModelConfigList, bg_numClasses,
+	                     &classModelConfig_t::humanName, name );
 
-	return &nullClassModelConfig;
+	return i >= 0 ? &bg_classModelConfigList[ i ] : &nullClassModelConfig;
 }
 
 /*
@@ -484,7 +598,7 @@ int BG_GetBarbRegenerationInterval(const playerState_t& ps)
 BG_InitClassAttributes
 ===============
 */
-static void BG_InitClassAttributes()
+static void BG_InitClassAttributes( bool parse )
 {
 	const classData_t *cd;
 	classAttributes_t *ca;
@@ -504,6 +618,11 @@ static void BG_InitClassAttributes()
 		ca->abilities = 0;
 		ca->sprintMod = 1.0f;
 
+		if ( !parse )
+		{
+			continue;
+		}
+
 		BG_ParseClassAttributeFile( va( "configs/classes/%s.attr.cfg", ca->name ), ca );
 	}
 }
@@ -513,8 +632,13 @@ static void BG_InitClassAttributes()
 BG_InitClassModelConfigs
 ===============
 */
-static void BG_InitClassModelConfigs()
+static void BG_InitClassModelConfigs( bool parse )
 {
+	if ( !parse )
+	{
+		return;
+	}
+
 	for ( int i = PCL_NONE; i < PCL_NUM_CLASSES; i++ )
 	{
 		classModelConfig_t *cc = BG_ClassModelConfig( i );
@@ -569,17 +693,14 @@ static weaponAttributes_t bg_weapons[ ARRAY_LEN( bg_weaponsData ) ];
 
 static const weaponAttributes_t nullWeapon {};
 
+static nameIndex_t bg_weaponNameIndex;
+
 weapon_t BG_WeaponNumberByName( const char *name )
 {
-	for ( unsigned i = 0; i < bg_numWeapons; i++ )
-	{
-		if ( !Q_stricmp( bg_weaponsData[ i ].name, name ) )
-		{
-			return bg_weaponsData[ i ].number;
-		}
-	}
+	int i = BG_FindName( bg_weaponNameIndex, bg_weaponsData, bg_numWeapons,
+	                     &weaponData_t::name, name );
 
-	return ( weapon_t )0;
+	return i >= 0 ? bg_weaponsData[ i ].number : ( weapon_t )0;
 }
 
 const weaponAttributes_t *BG_WeaponByName( const char *name )
@@ -612,7 +733,7 @@ const weaponAttributes_t *BG_Weapon( int weapon )
 BG_InitWeaponAttributes
 ===============
 */
-static void BG_InitWeaponAttributes()
+static void BG_InitWeaponAttributes( bool parse )
 {
 	const weaponData_t *wd;
 	weaponAttributes_t *wa;
@@ -630,6 +751,11 @@ static void BG_InitWeaponAttributes()
 		// set default values for optional fields
 		wa->knockbackScale = 1.0f;
 
+		if ( !parse )
+		{
+			continue;
+		}
+
 		BG_ParseWeaponAttributeFile( va( "configs/weapon/%s.attr.cfg", wa->name ), wa );
 	}
 }
@@ -666,6 +792,8 @@ static upgradeAttributes_t bg_upgrades[ ARRAY_LEN( bg_upgradesData ) ];
 
 static const upgradeAttributes_t nullUpgrade {};
 
+static nameIndex_t bg_upgradeNameIndex;
+
 /*
 ==============
 BG_UpgradeByName
@@ -673,15 +801,10 @@ BG_UpgradeByName
 */
 const upgradeAttributes_t *BG_UpgradeByName( const char *name )
 {
-	for ( unsigned i = 0; i < bg_numUpgrades; i++ )
-	{
-		if ( !Q_stricmp( bg_upgrades[ i ].name, name ) )
-		{
-			return &bg_upgrades[ i ];
-		}
-	}
+	int i = BG_FindName( bg_upgradeNameIndex, bg_upgrades, bg_numUpgrades,
+	                     &upgradeAttributes_t::name, name );
 
-	return &nullUpgrade;
+	return i >= 0 ? &bg_upgrades[ i ] : &nullUpgrade;
 }
 
 /*
@@ -700,7 +823,7 @@ const upgradeAttributes_t *BG_Upgrade( int upgrade )
 BG_InitUpgradeAttributes
 ===============
 */
-static void BG_InitUpgradeAttributes()
+static void BG_InitUpgradeAttributes( bool parse )
 {
 	const upgradeData_t *ud;
 	upgradeAttributes_t *ua;
@@ -716,6 +839,11 @@ static void BG_InitUpgradeAttributes()
 		ua->number = ud->number;
 		ua->name = ud->name;
 
+		if ( !parse )
+		{
+			continue;
+		}
+
 		BG_ParseUpgradeAttributeFile( va( "configs/upgrades/%s.attr.cfg", ua->name ), ua );
 	}
 }
@@ -749,6 +877,7 @@ static const missileData_t bg_missilesData[] =
 static const size_t              bg_numMissiles = ARRAY_LEN( bg_missilesData );
 static missileAttributes_t       bg_missiles[ ARRAY_LEN( bg_missilesData ) ];
 static const missileAttributes_t nullMissile {};
+static nameIndex_t               bg_missileNameIndex;
 
 /*
 ==============
@@ -757,15 +886,10 @@ BG_MissileByName
 */
 const missileAttributes_t *BG_MissileByName( const char *name )
 {
-	for ( unsigned i = 0; i < bg_numMissiles; i++ )
-	{
-		if ( !Q_stricmp( bg_missiles[ i ].name, name ) )
-		{
-			return &bg_missiles[ i ];
-		}
-	}
+	int i = BG_FindName( bg_missileNameIndex, bg_missiles, bg_numMissiles,
+	                     &missileAttributes_t::name, name );
 
-	return &nullMissile;
+	return i >= 0 ? &bg_missiles[ i ] : &nullMissile;
 }
 
 /*
@@ -874,6 +998,8 @@ static const meansOfDeathData_t bg_meansOfDeathData[] =
 
 static const size_t bg_numMeansOfDeath = ARRAY_LEN( bg_meansOfDeathData );
 
+static nameIndex_t bg_meansOfDeathNameIndex;
+
 /*
 ==============
 BG_MeansOfDeathByName
@@ -881,15 +1007,10 @@ BG_MeansOfDeathByName
 */
 meansOfDeath_t BG_MeansOfDeathByName( const char *name )
 {
-	for ( unsigned i = 0; i < bg_numMeansOfDeath; i++ )
-	{
-		if ( !Q_stricmp( bg_meansOfDeathData[ i ].name, name ) )
-		{
-			return bg_meansOfDeathData[ i ].number;
-		}
-	}
+	int i = BG_FindName( bg_meansOfDeathNameIndex, bg_meansOfDeathData, bg_numMeansOfDeath,
+	                     &meansOfDeathData_t::name, name );
 
-	return MOD_UNKNOWN;
+	return i >= 0 ? bg_meansOfDeathData[ i ].number : MOD_UNKNOWN;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -918,6 +1039,7 @@ static const beaconData_t bg_beaconsData[ ] =
 
 static const size_t bg_numBeacons = ARRAY_LEN( bg_beaconsData );
 static beaconAttributes_t bg_beacons[ ARRAY_LEN( bg_beaconsData ) ];
+static nameIndex_t bg_beaconNameIndex;
 
 /*
 ================
@@ -926,11 +1048,10 @@ BG_BeaconByName
 */
 const beaconAttributes_t *BG_BeaconByName( const char *name )
 {
-	for ( unsigned i = 0; i < bg_numBeacons; i++ )
-		if ( !Q_stricmp( bg_beacons[ i ].name, name ) )
-			return bg_beacons + i;
+	int i = BG_FindName( bg_beaconNameIndex, bg_beacons, bg_numBeacons,
+	                     &beaconAttributes_t::name, name );
 
-	return nullptr;
+	return i >= 0 ? bg_beacons + i : nullptr;
 }
 
 /*
@@ -978,27 +1099,798 @@ static void BG_InitBeaconAttributes()
 
 /*
 ================
-BG_InitAllConfigs
+Config cache
+
+The buildable, class, weapon and upgrade configs and the config vars
+they set are saved after a successful parse, together with a hash of
+the files they came from. While the files stay the same, the next load
+reads the saved values instead of parsing the files again. Missiles and
+beacons register models, shaders and sounds while they are parsed, so
+they are always parsed.
+================
+*/
 
+static Cvar::Range<Cvar::Cvar<int>> bg_configCache(
+	VM_STRING_PREFIX "configCache",
+	"save parsed configs: 0 off, 1 on, 2 parse anyway and compare with the saved configs",
+	Cvar::NONE, 1, 0, 2 );
+
+#define CONFIG_CACHE_FILE    "cache/" VM_STRING_PREFIX "configs.dat"
+#define CONFIG_CACHE_MAGIC   0x43474342 // "BCGC"
+#define CONFIG_CACHE_VERSION 1
+
+enum class cacheFieldType_t
+{
+	INT,
+	FLOAT,
+	BOOL,
+	VEC3,
+	CHARS,
+	STRING, // allocated with BG_strdup
+	OPTIONAL_STRING // like STRING, but a static "" when empty
+};
+
+struct cacheField_t
+{
+	const char       *name;
+	size_t           offset;
+	size_t           size;
+	cacheFieldType_t type;
+};
+
+#define CACHE_FIELD( s, f, t ) { #f, offsetof( s, f ), sizeof( s::f ), cacheFieldType_t::t }
+
+// fields which are set before parsing, like the names, are left out
+static const cacheField_t buildableCacheFields[] =
+{
+	CACHE_FIELD( buildableAttributes_t, humanName, STRING ),
+	CACHE_FIELD( buildableAttributes_t, info, STRING ),
+	CACHE_FIELD( buildableAttributes_t, icon, STRING ),
+	CACHE_FIELD( buildableAttributes_t, traj, INT ),
+	CACHE_FIELD( buildableAttributes_t, bounce, FLOAT ),
+	CACHE_FIELD( buildableAttributes_t, buildPoints, INT ),
+	CACHE_FIELD( buildableAttributes_t, unlockThreshold, INT ),
+	CACHE_FIELD( buildableAttributes_t, health, INT ),
+	CACHE_FIELD( buildableAttributes_t, regenRate, INT ),
+	CACHE_FIELD( buildableAttributes_t, splashDamage, INT ),
+	CACHE_FIELD( buildableAttributes_t, splashRadius, INT ),
+	CACHE_FIELD( buildableAttributes_t, weapon, INT ),
+	CACHE_FIELD( buildableAttributes_t, meansOfDeath, INT ),
+	CACHE_FIELD( buildableAttributes_t, team, INT ),
+	CACHE_FIELD( buildableAttributes_t, buildWeapon, INT ),
+	CACHE_FIELD( buildableAttributes_t, buildTime, INT ),
+	CACHE_FIELD( buildableAttributes_t, usable, BOOL ),
+	CACHE_FIELD( buildableAttributes_t, minNormal, FLOAT ),
+	CACHE_FIELD( buildableAttributes_t, invertNormal, BOOL ),
+	CACHE_FIELD( buildableAttributes_t, creepSize, INT ),
+	CACHE_FIELD( buildableAttributes_t, transparentTest, BOOL ),
+	CACHE_FIELD( buildableAttributes_t, uniqueTest, BOOL ),
+	CACHE_FIELD( buildableAttributes_t, dretchAttackable, BOOL ),
+};
+
+static const cacheField_t buildableModelCacheFields[] =
+{
+	CACHE_FIELD( buildableModelConfig_t, models, CHARS ),
+	CACHE_FIELD( buildableModelConfig_t, modelScale, FLOAT ),
+	CACHE_FIELD( buildableModelConfig_t, modelRotation, VEC3 ),
+	CACHE_FIELD( buildableModelConfig_t, mins, VEC3 ),
+	CACHE_FIELD( buildableModelConfig_t, maxs, VEC3 ),
+	CACHE_FIELD( buildableModelConfig_t, zOffset, FLOAT ),
+	CACHE_FIELD( buildableModelConfig_t, oldScale, FLOAT ),
+	CACHE_FIELD( buildableModelConfig_t, oldOffset, FLOAT ),
+};
+
+static const cacheField_t classCacheFields[] =
+{
+	CACHE_FIELD( classAttributes_t, info, OPTIONAL_STRING ),
+	CACHE_FIELD( classAttributes_t, icon, STRING ),
+	CACHE_FIELD( classAttributes_t, fovCvar, OPTIONAL_STRING ),
+	CACHE_FIELD( classAttributes_t, team, INT ),
+	CACHE_FIELD( classAttributes_t, unlockThreshold, INT ),
+	CACHE_FIELD( classAttributes_t, health, INT ),
+	CACHE_FIELD( classAttributes_t, fallDamage, FLOAT ),
+	CACHE_FIELD( classAttributes_t, regenRate, FLOAT ),
+	CACHE_FIELD( classAttributes_t, abilities, INT ),
+	CACHE_FIELD( classAttributes_t, startWeapon, INT ),
+	CACHE_FIELD( classAttributes_t, buildDist, FLOAT ),
+	CACHE_FIELD( classAttributes_t, fov, INT ),
+	CACHE_FIELD( classAttributes_t, bob, FLOAT ),
+	CACHE_FIELD( classAttributes_t, bobCycle, FLOAT ),
+	CACHE_FIELD( classAttributes_t, steptime, INT ),
+	CACHE_FIELD( classAttributes_t, speed, FLOAT ),
+	CACHE_FIELD( classAttributes_t, sprintMod, FLOAT ),
+	CACHE_FIELD( classAttributes_t, acceleration, FLOAT ),
+	CACHE_FIELD( classAttributes_t, airAcceleration, FLOAT ),
+	CACHE_FIELD( classAttributes_t, friction, FLOAT ),
+	CACHE_FIELD( classAttributes_t, stopSpeed, FLOAT ),
+	CACHE_FIELD( classAttributes_t, jumpMagnitude, FLOAT ),
+	CACHE_FIELD( classAttributes_t, mass, INT ),
+	CACHE_FIELD( classAttributes_t, staminaJumpCost, INT ),
+	CACHE_FIELD( classAttributes_t, staminaSprintCost, INT ),
+	CACHE_FIELD( classAttributes_t, staminaJogRestore, INT ),
+	CACHE_FIELD( classAttributes_t, staminaWalkRestore, INT ),
+	CACHE_FIELD( classAttributes_t, staminaStopRestore, INT ),
+	CACHE_FIELD( classAttributes_t, price, INT ),
+};
+
+// navHandle is set up by the bots later on
+static const cacheField_t classModelCacheFields[] =
+{
+	CACHE_FIELD( classModelConfig_t, modelName, CHARS ),
+	CACHE_FIELD( classModelConfig_t, modelScale, FLOAT ),
+	CACHE_FIELD( classModelConfig_t, skinName, CHARS ),
+	CACHE_FIELD( classModelConfig_t, shadowScale, FLOAT ),
+	CACHE_FIELD( classModelConfig_t, hudName, CHARS ),
+	CACHE_FIELD( classModelConfig_t, humanName, STRING ),
+	CACHE_FIELD( classModelConfig_t, mins, VEC3 ),
+	CACHE_FIELD( classModelConfig_t, maxs, VEC3 ),
+	CACHE_FIELD( classModelConfig_t, crouchMaxs, VEC3 ),
+	CACHE_FIELD( classModelConfig_t, deadMins, VEC3 ),
+	CACHE_FIELD( classModelConfig_t, deadMaxs, VEC3 ),
+	CACHE_FIELD( classModelConfig_t, viewheight, INT ),
+	CACHE_FIELD( classModelConfig_t, crouchViewheight, INT ),
+	CACHE_FIELD( classModelConfig_t, zOffset, FLOAT ),
+	CACHE_FIELD( classModelConfig_t, shoulderOffsets, VEC3 ),
+	CACHE_FIELD( classModelConfig_t, segmented, BOOL ),
+	CACHE_FIELD( classModelConfig_t, navMeshClass, INT ),
+};
+
+static const cacheField_t weaponCacheFields[] =
+{
+	CACHE_FIELD( weaponAttributes_t, price, INT ),
+	CACHE_FIELD( weaponAttributes_t, unlockThreshold, INT ),
+	CACHE_FIELD( weaponAttributes_t, slots, INT ),
+	CACHE_FIELD( weaponAttributes_t, humanName, STRING ),
+	CACHE_FIELD( weaponAttributes_t, info, OPTIONAL_STRING ),
+	CACHE_FIELD( weaponAttributes_t, maxAmmo, INT ),
+	CACHE_FIELD( weaponAttributes_t, maxClips, INT ),
+	CACHE_FIELD( weaponAttributes_t, infiniteAmmo, BOOL ),
+	CACHE_FIELD( weaponAttributes_t, usesEnergy, BOOL ),
+	CACHE_FIELD( weaponAttributes_t, repeatRate1, INT ),
+	CACHE_FIELD( weaponAttributes_t, repeatRate2, INT ),
+	CACHE_FIELD( weaponAttributes_t, repeatRate3, INT ),
+	CACHE_FIELD( weaponAttributes_t, reloadTime, INT ),
+	CACHE_FIELD( weaponAttributes_t, knockbackScale, FLOAT ),
+	CACHE_FIELD( weaponAttributes_t, hasAltMode, BOOL ),
+	CACHE_FIELD( weaponAttributes_t, hasThirdMode, BOOL ),
+	CACHE_FIELD( weaponAttributes_t, canZoom, BOOL ),
+	CACHE_FIELD( weaponAttributes_t, zoomFov, FLOAT ),
+	CACHE_FIELD( weaponAttributes_t, purchasable, BOOL ),
+	CACHE_FIELD( weaponAttributes_t, longRanged, BOOL ),
+	CACHE_FIELD( weaponAttributes_t, team, INT ),
+};
+
+static const cacheField_t upgradeCacheFields[] =
+{
+	CACHE_FIELD( upgradeAttributes_t, price, INT ),
+	CACHE_FIELD( upgradeAttributes_t, unlockThreshold, INT ),
+	CACHE_FIELD( upgradeAttributes_t, slots, INT ),
+	CACHE_FIELD( upgradeAttributes_t, humanName, STRING ),
+	CACHE_FIELD( upgradeAttributes_t, info, OPTIONAL_STRING ),
+	CACHE_FIELD( upgradeAttributes_t, icon, STRING ),
+	CACHE_FIELD( upgradeAttributes_t, purchasable, BOOL ),
+	CACHE_FIELD( upgradeAttributes_t, usable, BOOL ),
+	CACHE_FIELD( upgradeAttributes_t, team, INT ),
+};
+
+struct cacheTable_t
+{
+	const char         *name;
+	const cacheField_t *fields;
+	size_t             numFields;
+	char               *items;
+	size_t             numItems;
+	size_t             stride;
+};
+
+#define CACHE_TABLE( name, fields, list, count ) \
+	{ name, fields, ARRAY_LEN( fields ), ( char * ) list, count, sizeof( list[ 0 ] ) }
+
+static const cacheTable_t cacheTables[] =
+{
+	CACHE_TABLE( "buildable", buildableCacheFields, bg_buildableList, bg_numBuildables ),
+	CACHE_TABLE( "buildable model", buildableModelCacheFields, bg_buildableModelConfigList, BA_NUM_BUILDABLES ),
+	CACHE_TABLE( "class", classCacheFields, bg_classList, bg_numClasses ),
+	CACHE_TABLE( "class model", classModelCacheFields, bg_classModelConfigList, PCL_NUM_CLASSES ),
+	CACHE_TABLE( "weapon", weaponCacheFields, bg_weapons, bg_numWeapons ),
+	CACHE_TABLE( "upgrade", upgradeCacheFields, bg_upgrades, bg_numUpgrades ),
+};
+
+static uint32_t BG_HashConfigFile( uint32_t hash, const char *filename )
+{
+	std::error_code err;
+	std::string     text = FS::PakPath::ReadFile( filename, err );
+
+	hash = BG_HashBytes( hash, filename, strlen( filename ) + 1 );
+
+	if ( err )
+	{
+		return BG_HashBytes( hash, "\xff", 1 );
+	}
+
+	return BG_HashBytes( hash, text.data(), text.size() );
+}
+
+/*
+================
+BG_HashConfigFiles
+
+Hashes every file the cached configs are parsed from, in the order they
+are parsed in, along with the layout of the cached data
 ================
 */
+static uint32_t BG_HashConfigFiles()
+{
+	uint32_t hash = BG_HASH_INIT;
+	int      numConfigVars = 0;
+	bool     *defined;
+	void     *value;
+	bool     isFloat;
 
-bool config_loaded = false;
+	for ( const cacheTable_t &table : cacheTables )
+	{
+		hash = BG_HashBytes( hash, &table.numItems, sizeof( table.numItems ) );
+		hash = BG_HashBytes( hash, &table.stride, sizeof( table.stride ) );
+	}
+
+	while ( BG_ConfigVar( numConfigVars, &defined, &value, &isFloat ) )
+	{
+		numConfigVars++;
+	}
+
+	hash = BG_HashBytes( hash, &numConfigVars, sizeof( numConfigVars ) );
+
+	for ( unsigned i = 0; i < bg_numBuildables; i++ )
+	{
+		hash = BG_HashConfigFile( hash, va( "configs/buildables/%s.attr.cfg", bg_buildableNameList[ i ].name ) );
+	}
+
+	for ( int i = BA_NONE + 1; i < BA_NUM_BUILDABLES; i++ )
+	{
+		hash = BG_HashConfigFile( hash, va( "configs/buildables/%s.model.cfg", bg_buildableNameList[ i - 1 ].name ) );
+	}
+
+	for ( unsigned i = 0; i < bg_numClasses; i++ )
+	{
+		hash = BG_HashConfigFile( hash, va( "configs/classes/%s.attr.cfg", bg_classData[ i ].name ) );
+		hash = BG_HashConfigFile( hash, va( "configs/classes/%s.model.cfg", bg_classData[ i ].name ) );
+	}
+
+	for ( unsigned i = 0; i < bg_numWeapons; i++ )
+	{
+		hash = BG_HashConfigFile( hash, va( "configs/weapon/%s.attr.cfg", bg_weaponsData[ i ].name ) );
+	}
+
+	for ( unsigned i = 0; i < bg_numUpgrades; i++ )
+	{
+		hash = BG_HashConfigFile( hash, va( "configs/upgrades/%s.attr.cfg", bg_upgradesData[ i ].name ) );
+	}
+
+	return hash;
+}
+
+/*
+================
+BG_SaveConfigs
+
+Serializes the cached configs: every field of every item in table order,
+strings as a length (-1 for nullptr) followed by the characters, then
+every config var as its defined flag and value
+================
+*/
+static std::string BG_SaveConfigs()
+{
+	std::string out;
+	bool        *defined;
+	void        *value;
+	bool        isFloat;
+
+	for ( const cacheTable_t &table : cacheTables )
+	{
+		for ( size_t i = 0; i < table.numItems; i++ )
+		{
+			const char *item = table.items + i * table.stride;
+
+			for ( size_t j = 0; j < table.numFields; j++ )
+			{
+				const cacheField_t &field = table.fields[ j ];
+
+				if ( field.type == cacheFieldType_t::STRING || field.type == cacheFieldType_t::OPTIONAL_STRING )
+				{
+					const char *string = *( const char * const * )( item + field.offset );
+					int32_t    length = string ? strlen( string ) : -1;
+
+					out.append( ( const char * ) &length, sizeof( length ) );
+
+					if ( string )
+					{
+						out.append( string, length );
+					}
+				}
+				else
+				{
+					out.append( item + field.offset, field.size );
+				}
+			}
+		}
+	}
+
+	for ( int i = 0; BG_ConfigVar( i, &defined, &value, &isFloat ); i++ )
+	{
+		out.append( ( const char * ) defined, sizeof( bool ) );
+		out.append( ( const char * ) value, 4 );
+	}
+
+	return out;
+}
+
+struct cacheReader_t
+{
+	const char *p;
+	const char *end;
+
+	bool Read( std::string &value, size_t size )
+	{
+		if ( ( size_t )( end - p ) < size )
+		{
+			return false;
+		}
+
+		value.assign( p, size );
+		p += size;
+		return true;
+	}
+
+	// a nullptr string is read as an empty one with isNull set
+	bool ReadField( const cacheField_t &field, std::string &value, bool &isNull )
+	{
+		isNull = false;
+
+		if ( field.type != cacheFieldType_t::STRING && field.type != cacheFieldType_t::OPTIONAL_STRING )
+		{
+			return Read( value, field.size );
+		}
+
+		int32_t length;
+
+		if ( !Read( value, sizeof( length ) ) )
+		{
+			return false;
+		}
+
+		memcpy( &length, value.data(), sizeof( length ) );
+
+		if ( length < 0 )
+		{
+			isNull = true;
+			value.clear();
+			return true;
+		}
+
+		return Read( value, length );
+	}
+};
+
+/*
+================
+BG_LoadConfigs
+
+Fills in the cached configs from BG_SaveConfigs output. The items must
+have been initialised without parsing first.
+================
+*/
+static bool BG_LoadConfigs( const std::string &data )
+{
+	cacheReader_t reader{ data.data(), data.data() + data.size() };
+	std::string   value;
+	bool          isNull;
+	bool          *defined;
+	void          *var;
+	bool          isFloat;
+
+	for ( const cacheTable_t &table : cacheTables )
+	{
+		for ( size_t i = 0; i < table.numItems; i++ )
+		{
+			char *item = table.items + i * table.stride;
+
+			for ( size_t j = 0; j < table.numFields; j++ )
+			{
+				const cacheField_t &field = table.fields[ j ];
+
+				if ( !reader.ReadField( field, value, isNull ) )
+				{
+					return false;
+				}
+
+				if ( field.type == cacheFieldType_t::STRING || field.type == cacheFieldType_t::OPTIONAL_STRING )
+				{
+					char **string = ( char ** )( item + field.offset );
+
+					if ( isNull )
+					{
+						*string = nullptr;
+					}
+					else if ( value.empty() && field.type == cacheFieldType_t::OPTIONAL_STRING )
+					{
+						*string = ( char * ) "";
+					}
+					else
+					{
+						*string = BG_strdup( value.c_str() );
+					}
+				}
+				else
+				{
+					memcpy( item + field.offset, value.data(), field.size );
+				}
+			}
+		}
+	}
+
+	for ( int i = 0; BG_ConfigVar( i, &defined, &var, &isFloat ); i++ )
+	{
+		if ( !reader.Read( value, sizeof( bool ) ) )
+		{
+			return false;
+		}
+
+		memcpy( defined, value.data(), sizeof( bool ) );
+
+		if ( !reader.Read( value, 4 ) )
+		{
+			return false;
+		}
+
+		memcpy( var, value.data(), 4 );
+	}
+
+	return reader.p == reader.end;
+}
+
+static std::string BG_CacheFieldToString( const cacheField_t &field, const std::string &value, bool isNull )
+{
+	switch ( field.type )
+	{
+		case cacheFieldType_t::INT:
+		{
+			int i;
+			memcpy( &i, value.data(), sizeof( i ) );
+			return std::to_string( i );
+		}
+
+		case cacheFieldType_t::FLOAT:
+		{
+			float f;
+			memcpy( &f, value.data(), sizeof( f ) );
+			return Str::Format( "%g", f );
+		}
+
+		case cacheFieldType_t::BOOL:
+			return value[ 0 ] ? "true" : "false";
+
+		case cacheFieldType_t::VEC3:
+		{
+			vec3_t v;
+			memcpy( v, value.data(), sizeof( v ) );
+			return Str::Format( "( %g %g %g )", v[ 0 ], v[ 1 ], v[ 2 ] );
+		}
+
+		case cacheFieldType_t::CHARS:
+			return Str::Format( "\"%s\"", value.c_str() );
+
+		default:
+			return isNull ? "null" : Str::Format( "\"%s\"", value );
+	}
+}
+
+/*
+================
+BG_CompareConfigs
+
+Walks two BG_SaveConfigs outputs side by side and warns about every
+field that differs, returns the number of differences
+================
+*/
+static int BG_CompareConfigs( const std::string &cached, const std::string &parsed )
+{
+	cacheReader_t cachedReader{ cached.data(), cached.data() + cached.size() };
+	cacheReader_t parsedReader{ parsed.data(), parsed.data() + parsed.size() };
+	std::string   cachedValue, parsedValue;
+	bool          cachedNull, parsedNull;
+	bool          *defined;
+	void          *var;
+	bool          isFloat;
+	int           differences = 0;
+
+	for ( const cacheTable_t &table : cacheTables )
+	{
+		for ( size_t i = 0; i < table.numItems; i++ )
+		{
+			for ( size_t j = 0; j < table.numFields; j++ )
+			{
+				const cacheField_t &field = table.fields[ j ];
+
+				if ( !cachedReader.ReadField( field, cachedValue, cachedNull ) ||
+				     !parsedReader.ReadField( field, parsedValue, parsedNull ) )
+				{
+					Log::Warn( "config cache: saved configs are truncated" );
+					return differences + 1;
+				}
+
+				if ( cachedNull != parsedNull || cachedValue != parsedValue )
+				{
+					Log::Warn( "config cache: %s %d %s is %s in the cache but %s in the files",
+					           table.name, ( int ) i, field.name,
+					           BG_CacheFieldToString( field, cachedValue, cachedNull ),
+					           BG_CacheFieldToString( field, parsedValue, parsedNull ) );
+					differences++;
+				}
+			}
+		}
+	}
+
+	for ( int i = 0; const char *name = BG_ConfigVar( i, &defined, &var, &isFloat ); i++ )
+	{
+		if ( !cachedReader.Read( cachedValue, sizeof( bool ) + 4 ) ||
+		     !parsedReader.Read( parsedValue, sizeof( bool ) + 4 ) )
+		{
+			Log::Warn( "config cache: saved configs are truncated" );
+			return differences + 1;
+		}
+
+		if ( cachedValue != parsedValue )
+		{
+			Log::Warn( "config cache: config var %s differs", name );
+			differences++;
+		}
+	}
+
+	return differences;
+}
+
+/*
+================
+BG_ReadConfigCache
+
+Returns the saved configs if they were saved for files with this hash
+================
+*/
+static bool BG_ReadConfigCache( uint32_t hash, std::string &data )
+{
+	fileHandle_t f;
+	int          length = trap_FS_FOpenFile( CONFIG_CACHE_FILE, &f, fsMode_t::FS_READ );
+	int32_t      header[ 3 ];
+
+	if ( !f )
+	{
+		return false;
+	}
+
+	if ( length < ( int ) sizeof( header ) )
+	{
+		trap_FS_FCloseFile( f );
+		return false;
+	}
+
+	trap_FS_Read( header, sizeof( header ), f );
+
+	if ( header[ 0 ] != CONFIG_CACHE_MAGIC || header[ 1 ] != CONFIG_CACHE_VERSION || ( uint32_t ) header[ 2 ] != hash )
+	{
+		trap_FS_FCloseFile( f );
+		return false;
+	}
+
+	data.resize( length - sizeof( header ) );
+	trap_FS_Read( &data[ 0 ], data.size(), f );
+	trap_FS_FCloseFile( f );
+
+	return true;
+}
+
+static void BG_WriteConfigCache( uint32_t hash, const std::string &data )
+{
+	fileHandle_t f;
+	int32_t      header[ 3 ] = { CONFIG_CACHE_MAGIC, CONFIG_CACHE_VERSION, ( int32_t ) hash };
+
+	trap_FS_FOpenFile( CONFIG_CACHE_FILE, &f, fsMode_t::FS_WRITE_VIA_TEMPORARY );
+
+	if ( !f )
+	{
+		Log::Warn( "couldn't write the config cache %s", CONFIG_CACHE_FILE );
+		return;
+	}
+
+	trap_FS_Write( header, sizeof( header ), f );
+	trap_FS_Write( data.data(), data.size(), f );
+	trap_FS_FCloseFile( f );
+}
+
+/*
+================
+BG_ResetNameIndexes
+
+Makes the name indexes rebuild themselves, called whenever the names
+they were built from may have changed
+================
+*/
+static void BG_ResetNameIndexes()
+{
+	bg_buildableNameIndex.built = false;
+	bg_buildableEntityNameIndex.built = false;
+	bg_classNameIndex.built = false;
+	bg_classModelNameIndex.built = false;
+	bg_weaponNameIndex.built = false;
+	bg_upgradeNameIndex.built = false;
+	bg_missileNameIndex.built = false;
+	bg_meansOfDeathNameIndex.built = false;
+	bg_beaconNameIndex.built = false;
+}
+
+/*
+================
+BG_CheckNameIndex
+
+Looks up every name of a registry, as it is and upper cased, and checks
+the index finds the same item a linear scan does
+================
+*/
+template<typename T, typename S>
+static int BG_CheckNameIndex( const char *registry, nameIndex_t &index, const T *items, size_t count, S T::*name )
+{
+	int failures = 0;
+
+	for ( size_t i = 0; i < count; i++ )
+	{
+		if ( !( items[ i ].*name ) )
+		{
+			continue;
+		}
+
+		std::string upper = items[ i ].*name;
+
+		for ( char &c : upper )
+		{
+			c = Str::ctoupper( c );
+		}
+
+		for ( const char *key : { ( const char * ) ( items[ i ].*name ), upper.c_str() } )
+		{
+			int expected = -1;
+
+			for ( size_t j = 0; j < count && expected < 0; j++ )
+			{
+				if ( items[ j ].*name && !Q_stricmp( items[ j ].*name, key ) )
+				{
+					expected = j;
+				}
+			}
+
+			int found = BG_FindName( index, items, count, name, key );
+
+			if ( found != expected )
+			{
+				Log::Warn( "%s name index finds item %d for \"%s\" instead of %d",
+				           registry, found, key, expected );
+				failures++;
+			}
+		}
+	}
+
+	return failures;
+}
+
+/*
+================
+BG_CheckNameIndexes
+================
+*/
+static void BG_CheckNameIndexes()
+{
+	int failures = 0;
+
+	failures += BG_CheckNameIndex( "buildable", bg_buildableNameIndex, bg_buildableList, bg_numBuildables,
+	                               &buildableAttributes_t::name );
+	failures += BG_CheckNameIndex( "buildable entity", bg_buildableEntityNameIndex, bg_buildableList, bg_numBuildables,
+	                               &buildableAttributes_t::entityName );
+	failures += BG_CheckNameIndex( "class", bg_classNameIndex, bg_classList, bg_numClasses,
+	                               &classAttributes_t::name );
+	failures += BG_CheckNameIndex( "class model", bg_classModelNameIndex, bg_classModelConfigList, bg_numClasses,
+	                               &classModelConfig_t::humanName );
+	failures += BG_CheckNameIndex( "weapon", bg_weaponNameIndex, bg_weaponsData, bg_numWeapons,
+	                               &weaponData_t::name );
+	failures += BG_CheckNameIndex( "upgrade", bg_upgradeNameIndex, bg_upgrades, bg_numUpgrades,
+	                               &upgradeAttributes_t::name );
+	failures += BG_CheckNameIndex( "missile", bg_missileNameIndex, bg_missiles, bg_numMissiles,
+	                               &missileAttributes_t::name );
+	failures += BG_CheckNameIndex( "means of death", bg_meansOfDeathNameIndex, bg_meansOfDeathData, bg_numMeansOfDeath,
+	                               &meansOfDeathData_t::name );
+	failures += BG_CheckNameIndex( "beacon", bg_beaconNameIndex, bg_beacons, bg_numBeacons,
+	                               &beaconAttributes_t::name );
+
+	if ( failures )
+	{
+		Log::Warn( "%d name index lookups failed", failures );
+	}
+}
+
+/*
+================
+BG_InitAllConfigs
+
+================
+*/
 
 void BG_InitAllConfigs()
 {
-	BG_InitBuildableAttributes();
-	BG_InitBuildableModelConfigs();
-	BG_InitClassAttributes();
-	BG_InitClassModelConfigs();
-	BG_InitWeaponAttributes();
-	BG_InitUpgradeAttributes();
+	int         cacheMode = bg_configCache.Get();
+	uint32_t    hash = 0;
+	std::string cached;
+
+	// lookups made while parsing scan the registries
+	config_loaded = false;
+	BG_ResetNameIndexes();
+
+	if ( cacheMode )
+	{
+		hash = BG_HashConfigFiles();
+
+		if ( BG_ReadConfigCache( hash, cached ) && cacheMode == 1 )
+		{
+			BG_InitBuildableAttributes( false );
+			BG_InitBuildableModelConfigs( false );
+			BG_InitClassAttributes( false );
+			BG_InitClassModelConfigs( false );
+			BG_InitWeaponAttributes( false );
+			BG_InitUpgradeAttributes( false );
+
+			if ( BG_LoadConfigs( cached ) )
+			{
+				BG_InitMissileAttributes();
+				BG_InitBeaconAttributes();
+
+				BG_CheckConfigVars();
+
+				config_loaded = true;
+				BG_CheckNameIndexes();
+				return;
+			}
+
+			Log::Warn( "config cache %s is damaged, parsing the configs", CONFIG_CACHE_FILE );
+			cached.clear();
+		}
+	}
+
+	BG_InitBuildableAttributes( true );
+	BG_InitBuildableModelConfigs( true );
+	BG_InitClassAttributes( true );
+	BG_InitClassModelConfigs( true );
+	BG_InitWeaponAttributes( true );
+	BG_InitUpgradeAttributes( true );
 	BG_InitMissileAttributes();
 	BG_InitBeaconAttributes();
 
-	BG_CheckConfigVars();
+	bool parsed = BG_CheckConfigVars();
 
 	config_loaded = true;
+	BG_CheckNameIndexes();
+
+	if ( cacheMode && parsed )
+	{
+		std::string saved = BG_SaveConfigs();
+
+		if ( !cached.empty() )
+		{
+			int differences = BG_CompareConfigs( cached, saved );
+
+			Log::Notice( "config cache: %d fields differ from the files", differences );
+		}
+
+		if ( saved != cached )
+		{
+			BG_WriteConfigCache( hash, saved );
+		}
+	}
 }
 
 /*
@@ -1018,6 +1910,8 @@ void BG_UnloadAllConfigs()
     }
     config_loaded = false;
 
+    BG_ResetNameIndexes();
+
     for ( unsigned i = 0; i < bg_numBuildables; i++ )
     {
         buildableAttributes_t &ba = bg_buildableList[i];
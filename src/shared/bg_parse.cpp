@@ -511,6 +511,29 @@ static bool BG_ParseConfigVar(configVar_t *var, const char **text, const char *f
 	return true;
 }
 
+/*
+======================
+BG_ConfigVar
+
+Gives the config cache access to the config vars, returns the name of the
+var at an index or nullptr past the last one
+======================
+*/
+
+const char *BG_ConfigVar( int index, bool **defined, void **value, bool *isFloat )
+{
+	if ( index < 0 || ( size_t ) index >= bg_numConfigVars )
+	{
+		return nullptr;
+	}
+
+	*defined = &bg_configVars[ index ].defined;
+	*value = bg_configVars[ index ].var;
+	*isFloat = bg_configVars[ index ].type == FLOAT;
+
+	return bg_configVars[ index ].name;
+}
+
 bool BG_CheckConfigVars()
 {
 	int ok = true;
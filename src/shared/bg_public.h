@@ -1563,6 +1563,11 @@ meansOfDeath_t            BG_MeansOfDeathByName( const char *name );
 void                      BG_InitAllConfigs();
 void                      BG_UnloadAllConfigs();
 
+// FNV-1a, start a new hash from BG_HASH_INIT
+#define BG_HASH_INIT 2166136261u
+uint32_t                  BG_HashBytes( uint32_t hash, const void *data, size_t size );
+uint32_t                  BG_HashNameLower( const char *name );
+
 /*
  * This class is a simpler std::vector alternative that doesn't allocate
  * and survives a memset(0) without damage, provided that you don't need to
@@ -1626,6 +1631,7 @@ public:
 // Parsers
 bool                  BG_ReadWholeFile( const char *filename, char *buffer, size_t size);
 bool                  BG_CheckConfigVars();
+const char            *BG_ConfigVar( int index, bool **defined, void **value, bool *isFloat );
 bool                  BG_NonSegModel( const char *filename );
 void                      BG_ParseBuildableAttributeFile( const char *filename, buildableAttributes_t *ba );
 void                      BG_ParseBuildableModelFile( const char *filename, buildableModelConfig_t *bc );
@@ -1726,6 +1732,7 @@ std::string BG_TacticBehaviorsToString( Str::StringRef sep );
 #define MAX_VOICES             8
 #define MAX_VOICE_NAME_LEN     16
 #define MAX_VOICE_CMD_LEN      16
+#define VOICE_CMD_HASH_SIZE    64 // must be a power of two
 #define VOICE_ENTHUSIASM_DECAY 0.5f // enthusiasm lost per second
 
 enum voiceChannel_t
@@ -1751,11 +1758,32 @@ struct voiceTrack_t
 	voiceTrack_t        *next;
 };
 
+// the tracks of a command with one enthusiasm that a team and class may use
+struct voiceTrackLevel_t
+{
+	int               enthusiasm;
+	int               numTracks;
+	int               *trackNums; // in list order, counted from 1
+};
+
+struct voiceTrackBucket_t
+{
+	int               numLevels;
+	voiceTrackLevel_t *levels; // by increasing enthusiasm
+};
+
 struct voiceCmd_t
 {
 	char              cmd[ MAX_VOICE_CMD_LEN ];
 	voiceTrack_t      *tracks;
 	voiceCmd_t        *next;
+
+	// filled in by BG_VoiceInit
+	voiceCmd_t        *hashNext;
+	int               num;
+	int               numTracks;
+	voiceTrack_t      **trackList;
+	voiceTrackBucket_t buckets[ NUM_TEAMS ][ PCL_NUM_CLASSES ];
 };
 
 struct voice_t
@@ -1763,17 +1791,22 @@ struct voice_t
 	char           name[ MAX_VOICE_NAME_LEN ];
 	voiceCmd_t     *cmds;
 	voice_t        *next;
+
+	// filled in by BG_VoiceInit
+	int            numCmds;
+	voiceCmd_t     **cmdList;
+	voiceCmd_t     *cmdHash[ VOICE_CMD_HASH_SIZE ];
 };
 
 voice_t      *BG_VoiceInit();
 void         BG_PrintVoices( voice_t *voices, int debugLevel );
 
 voice_t      *BG_VoiceByName( voice_t *head, const char *name );
-voiceCmd_t   *BG_VoiceCmdFind( voiceCmd_t *head, const char *name, int *cmdNum );
-voiceCmd_t   *BG_VoiceCmdByNum( voiceCmd_t *head, int num );
-voiceTrack_t *BG_VoiceTrackByNum( voiceTrack_t *head, int num );
+voiceCmd_t   *BG_VoiceCmdFind( voice_t *voice, const char *name, int *cmdNum );
+voiceCmd_t   *BG_VoiceCmdByNum( voice_t *voice, int num );
+voiceTrack_t *BG_VoiceTrackByNum( voiceCmd_t *cmd, int num );
 
-voiceTrack_t *BG_VoiceTrackFind( voiceTrack_t *head, int team,
+voiceTrack_t *BG_VoiceTrackFind( voiceCmd_t *cmd, int team,
                                  int pClass, int weapon,
                                  int enthusiasm, int *trackNum );
 
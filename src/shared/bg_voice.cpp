@@ -487,6 +487,157 @@ static voiceCmd_t *BG_VoiceParse( const char *name )
 	return top;
 }
 
+/*
+============
+BG_VoiceCmdHash
+============
+*/
+static unsigned BG_VoiceCmdHash( const char *name )
+{
+	return BG_HashNameLower( name ) & ( VOICE_CMD_HASH_SIZE - 1 );
+}
+
+/*
+============
+BG_VoiceTrackMatches
+
+Whether a track is meant for a team and class, regardless of enthusiasm
+============
+*/
+static bool BG_VoiceTrackMatches( const voiceTrack_t *vt, int team, int class_ )
+{
+	return !( vt->team >= 0 && !( vt->team & ( 1 << team ) ) ) &&
+	       !( vt->pClass >= 0 && !( vt->pClass & ( 1 << class_ ) ) );
+}
+
+/*
+============
+BG_VoiceCompileCmd
+
+Builds the track list and, for every team and class, the tracks they may
+use grouped by enthusiasm, so that BG_VoiceTrackFind does not have to
+walk all the tracks twice
+============
+*/
+static void BG_VoiceCompileCmd( voiceCmd_t *cmd )
+{
+	std::vector<std::pair<int, int>> matches;
+	voiceTrack_t *vt;
+	int          i;
+
+	cmd->numTracks = 0;
+
+	for ( vt = cmd->tracks; vt; vt = vt->next )
+	{
+		cmd->numTracks++;
+	}
+
+	cmd->trackList = (voiceTrack_t**) BG_Alloc( std::max( cmd->numTracks, 1 ) * sizeof( voiceTrack_t * ) );
+
+	for ( vt = cmd->tracks, i = 0; vt; vt = vt->next, i++ )
+	{
+		cmd->trackList[ i ] = vt;
+	}
+
+	for ( int team = 0; team < NUM_TEAMS; team++ )
+	{
+		for ( int class_ = 0; class_ < PCL_NUM_CLASSES; class_++ )
+		{
+			voiceTrackBucket_t *bucket = &cmd->buckets[ team ][ class_ ];
+
+			matches.clear();
+
+			// tracks below enthusiasm 0 are never picked
+			for ( i = 0; i < cmd->numTracks; i++ )
+			{
+				vt = cmd->trackList[ i ];
+
+				if ( vt->enthusiasm >= 0 && BG_VoiceTrackMatches( vt, team, class_ ) )
+				{
+					matches.emplace_back( vt->enthusiasm, i + 1 );
+				}
+			}
+
+			// keeps list order within each enthusiasm
+			std::sort( matches.begin(), matches.end() );
+
+			bucket->numLevels = 0;
+			bucket->levels = nullptr;
+
+			if ( matches.empty() )
+			{
+				continue;
+			}
+
+			bucket->levels = (voiceTrackLevel_t*) BG_Alloc( matches.size() * sizeof( voiceTrackLevel_t ) );
+
+			for ( size_t j = 0; j < matches.size(); )
+			{
+				voiceTrackLevel_t *level = &bucket->levels[ bucket->numLevels++ ];
+				size_t            end = j;
+
+				while ( end < matches.size() && matches[ end ].first == matches[ j ].first )
+				{
+					end++;
+				}
+
+				level->enthusiasm = matches[ j ].first;
+				level->numTracks = end - j;
+				level->trackNums = (int*) BG_Alloc( level->numTracks * sizeof( int ) );
+
+				for ( int k = 0; k < level->numTracks; k++ )
+				{
+					level->trackNums[ k ] = matches[ j + k ].second;
+				}
+
+				j = end;
+			}
+		}
+	}
+}
+
+/*
+============
+BG_VoiceCompile
+
+Numbers the commands of a voice and hashes them by name
+============
+*/
+static void BG_VoiceCompile( voice_t *voice )
+{
+	voiceCmd_t *vc;
+	int        i;
+
+	memset( voice->cmdHash, 0, sizeof( voice->cmdHash ) );
+	voice->numCmds = 0;
+
+	for ( vc = voice->cmds; vc; vc = vc->next )
+	{
+		voice->numCmds++;
+	}
+
+	voice->cmdList = (voiceCmd_t**) BG_Alloc( std::max( voice->numCmds, 1 ) * sizeof( voiceCmd_t * ) );
+
+	for ( vc = voice->cmds, i = 0; vc; vc = vc->next, i++ )
+	{
+		voiceCmd_t **link = &voice->cmdHash[ BG_VoiceCmdHash( vc->cmd ) ];
+
+		voice->cmdList[ i ] = vc;
+		vc->num = i + 1;
+		vc->hashNext = nullptr;
+
+		// append, so that the first of several commands with a name is found
+		while ( *link )
+		{
+			link = &( *link )->hashNext;
+		}
+
+		*link = vc;
+
+		BG_VoiceCompileCmd( vc );
+	}
+}
+
 /*
 ============
 BG_VoiceInit
@@ -504,6 +655,7 @@ voice_t *BG_VoiceInit()
 	while ( voice )
 	{
 		voice->cmds = BG_VoiceParse( voice->name );
+		BG_VoiceCompile( voice );
 		voice = voice->next;
 	}
 
@@ -618,22 +770,19 @@ voice_t *BG_VoiceByName( voice_t *head, const char *name )
 BG_VoiceCmdFind
 ============
 */
-voiceCmd_t *BG_VoiceCmdFind( voiceCmd_t *head, const char *name, int *cmdNum )
+voiceCmd_t *BG_VoiceCmdFind( voice_t *voice, const char *name, int *cmdNum )
 {
-	voiceCmd_t *vc = head;
-	int        i = 0;
+	voiceCmd_t *vc = voice->cmdHash[ BG_VoiceCmdHash( name ) ];
 
 	while ( vc )
 	{
-		i++;
-
 		if ( !Q_stricmp( vc->cmd, name ) )
 		{
-			*cmdNum = i;
+			*cmdNum = vc->num;
 			return vc;
 		}
 
-		vc = vc->next;
+		vc = vc->hashNext;
 	}
 
 	return nullptr;
@@ -644,24 +793,14 @@ voiceCmd_t *BG_VoiceCmdFind( voiceCmd_t *head, const char *name, int *cmdNum )
 BG_VoiceCmdByNum
 ============
 */
-voiceCmd_t *BG_VoiceCmdByNum( voiceCmd_t *head, int num )
+voiceCmd_t *BG_VoiceCmdByNum( voice_t *voice, int num )
 {
-	voiceCmd_t *vc = head;
-	int        i = 0;
-
-	while ( vc )
+	if ( num < 1 || num > voice->numCmds )
 	{
-		i++;
-
-		if ( i == num )
-		{
-			return vc;
-		}
-
-		vc = vc->next;
+		return nullptr;
 	}
 
-	return nullptr;
+	return voice->cmdList[ num - 1 ];
 }
 
 /*
@@ -669,34 +808,26 @@ voiceCmd_t *BG_VoiceCmdByNum( voiceCmd_t *head, int num )
 BG_VoiceTrackByNum
 ============
 */
-voiceTrack_t *BG_VoiceTrackByNum( voiceTrack_t *head, int num )
+voiceTrack_t *BG_VoiceTrackByNum( voiceCmd_t *cmd, int num )
 {
-	voiceTrack_t *vt = head;
-	int          i = 0;
-
-	while ( vt )
+	if ( num < 1 || num > cmd->numTracks )
 	{
-		i++;
-
-		if ( i == num )
-		{
-			return vt;
-		}
-
-		vt = vt->next;
+		return nullptr;
 	}
 
-	return nullptr;
+	return cmd->trackList[ num - 1 ];
 }
 
 /*
 ============
-BG_VoiceTrackFind
+BG_VoiceTrackScan
+
+Picks a track by walking all of them, for teams and classes which have no
+bucket
 ============
 */
-voiceTrack_t *BG_VoiceTrackFind( voiceTrack_t *head, int team,
-                                 int class_, int,
-                                 int enthusiasm, int *trackNum )
+static voiceTrack_t *BG_VoiceTrackScan( voiceTrack_t *head, int team,
+                                        int class_, int enthusiasm, int *trackNum )
 {
 	voiceTrack_t *vt = head;
 	int          highestMatch = 0;
@@ -708,9 +839,7 @@ voiceTrack_t *BG_VoiceTrackFind( voiceTrack_t *head, int team,
 	// find highest enthusiasm without going over
 	while ( vt )
 	{
-		if ( ( vt->team >= 0 && !( vt->team  & ( 1 << team ) ) ) ||
-		     ( vt->pClass >= 0 && !( vt->pClass & ( 1 << class_ ) ) ) ||
-		     vt->enthusiasm > enthusiasm )
+		if ( !BG_VoiceTrackMatches( vt, team, class_ ) || vt->enthusiasm > enthusiasm )
 		{
 			vt = vt->next;
 			continue;
@@ -745,9 +874,7 @@ voiceTrack_t *BG_VoiceTrackFind( voiceTrack_t *head, int team,
 	{
 		j++;
 
-		if ( ( vt->team >= 0 && !( vt->team  & ( 1 << team ) ) ) ||
-		     ( vt->pClass >= 0 && !( vt->pClass & ( 1 << class_ ) ) ) ||
-		     vt->enthusiasm != highestMatch )
+		if ( !BG_VoiceTrackMatches( vt, team, class_ ) || vt->enthusiasm != highestMatch )
 		{
 			vt = vt->next;
 			continue;
@@ -765,3 +892,56 @@ voiceTrack_t *BG_VoiceTrackFind( voiceTrack_t *head, int team,
 
 	return nullptr;
 }
+
+/*
+============
+BG_VoiceTrackFind
+
+Picks one of the tracks with the highest enthusiasm not above the given
+one at random. The weapon is not used to pick tracks yet.
+============
+*/
+voiceTrack_t *BG_VoiceTrackFind( voiceCmd_t *cmd, int team,
+                                 int class_, int,
+                                 int enthusiasm, int *trackNum )
+{
+	const voiceTrackBucket_t *bucket;
+	const voiceTrackLevel_t  *level;
+	int                      low, high;
+
+	if ( team < 0 || team >= NUM_TEAMS || class_ < 0 || class_ >= PCL_NUM_CLASSES )
+	{
+		return BG_VoiceTrackScan( cmd->tracks, team, class_, enthusiasm, trackNum );
+	}
+
+	bucket = &cmd->buckets[ team ][ class_ ];
+
+	// find the first level above the enthusiasm
+	low = 0;
+	high = bucket->numLevels;
+
+	while ( low < high )
+	{
+		int mid = ( low + high ) / 2;
+
+		if ( bucket->levels[ mid ].enthusiasm <= enthusiasm )
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid;
+		}
+	}
+
+	if ( !low )
+	{
+		return nullptr;
+	}
+
+	// return randomly selected match
+	level = &bucket->levels[ low - 1 ];
+	*trackNum = level->trackNums[ rand() / ( RAND_MAX / level->numTracks + 1 ) ];
+
+	return cmd->trackList[ *trackNum - 1 ];
+}
@@ -230,6 +230,23 @@ struct directive_t
 
 int             numtokens;
 
+//tokens are handed out from blocks and recycled through a free list,
+//the blocks are released once no token is in use anymore
+#define TOKEN_BLOCK_SIZE 64
+
+struct tokenBlock_t
+{
+	tokenBlock_t *next;
+	token_t      tokens[ TOKEN_BLOCK_SIZE ];
+};
+
+static tokenBlock_t *tokenblocks;
+static token_t      *freetokens;
+
+//allocate and copy tokens one by one the way botlib did, to check the
+//pooled path against
+static bool         tokenreference;
+
 //list with global defines added to every source loaded
 define_t        *globaldefines;
 
@@ -1001,6 +1018,66 @@ static int Parse_ReadPunctuation( script_t *script, token_t *token )
 	return 0;
 }
 
+/*
+===============
+Parse_ClearToken
+
+Only the first character of the string is cleared, every reader
+terminates the string it writes
+===============
+*/
+static void Parse_ClearToken( token_t *token )
+{
+	if ( tokenreference )
+	{
+		memset( token, 0, sizeof( token_t ) );
+		return;
+	}
+
+	token->string[ 0 ] = '\0';
+	token->type = tokenType_t::TT_STRING;
+	token->subtype = 0;
+	token->intvalue = 0;
+	token->floatvalue = 0;
+	token->whitespace_p = nullptr;
+	token->endwhitespace_p = nullptr;
+	token->line = 0;
+	token->linescrossed = 0;
+	token->next = nullptr;
+}
+
+/*
+===============
+Parse_AssignToken
+
+Copies a token without the unused part of its string buffer
+===============
+*/
+static void Parse_AssignToken( token_t *dest, const token_t *src )
+{
+	if ( dest == src )
+	{
+		return;
+	}
+
+	if ( tokenreference )
+	{
+		memcpy( dest, src, sizeof( token_t ) );
+		return;
+	}
+
+	memcpy( dest->string, src->string, strlen( src->string ) + 1 );
+	dest->type = src->type;
+	dest->subtype = src->subtype;
+	dest->intvalue = src->intvalue;
+	dest->floatvalue = src->floatvalue;
+	dest->whitespace_p = src->whitespace_p;
+	dest->endwhitespace_p = src->endwhitespace_p;
+	dest->line = src->line;
+	dest->linescrossed = src->linescrossed;
+	dest->next = src->next;
+}
+
 /*
 ===============
 Parse_ReadPrimitive
@@ -1033,7 +1110,7 @@ static int Parse_ReadPrimitive( script_t *script, token_t *token )
 	token->string[ len ] = 0;
 
 	//copy the token into the script structure
-	memcpy( &script->token, token, sizeof( token_t ) );
+	Parse_AssignToken( &script->token, token );
 
 	//primitive reading successful
 	return 1;
@@ -1051,7 +1128,7 @@ static int Parse_ReadScriptToken( script_t *script, token_t *token )
 	//save line counter
 	script->lastline = script->line;
 	//clear the token stuff
-	memset( token, 0, sizeof( token_t ) );
+	Parse_ClearToken( token );
 	//start of the white space
 	script->whitespace_p = script->script_p;
 	token->whitespace_p = script->script_p;
@@ -1103,7 +1180,7 @@ static int Parse_ReadScriptToken( script_t *script, token_t *token )
 	}
 
 	//copy the token into the script structure
-	memcpy( &script->token, token, sizeof( token_t ) );
+	Parse_AssignToken( &script->token, token );
 	//successfully read a token
 	return 1;
 }
@@ -1344,17 +1421,43 @@ static token_t *Parse_CopyToken( const token_t *token )
 {
 	token_t *t;
 
-//  t = (token_t *) malloc(sizeof(token_t));
-	t = ( token_t * ) BG_Alloc( sizeof( token_t ) );
+	if ( tokenreference )
+	{
+		t = ( token_t * ) BG_Alloc( sizeof( token_t ) );
+
+		if ( !t )
+		{
+			Sys::Error( "out of token space" );
+		}
+
+		memcpy( t, token, sizeof( token_t ) );
+		t->next = nullptr;
+		numtokens++;
+		return t;
+	}
 
-//  t = freetokens;
-	if ( !t )
+	if ( !freetokens )
 	{
-		Sys::Error( "out of token space" );
+		tokenBlock_t *block = ( tokenBlock_t * ) BG_Alloc( sizeof( tokenBlock_t ) );
+
+		if ( !block )
+		{
+			Sys::Error( "out of token space" );
+		}
+
+		block->next = tokenblocks;
+		tokenblocks = block;
+
+		for ( int i = 0; i < TOKEN_BLOCK_SIZE; i++ )
+		{
+			block->tokens[ i ].next = freetokens;
+			freetokens = &block->tokens[ i ];
+		}
 	}
 
-//  freetokens = freetokens->next;
-	memcpy( t, token, sizeof( token_t ) );
+	t = freetokens;
+	freetokens = freetokens->next;
+	Parse_AssignToken( t, token );
 	t->next = nullptr;
 	numtokens++;
 	return t;
@@ -1367,12 +1470,64 @@ Parse_FreeToken
 */
 static void Parse_FreeToken( token_t *token )
 {
-	BG_Free( token );
-//  token->next = freetokens;
-//  freetokens = token;
+	if ( tokenreference )
+	{
+		BG_Free( token );
+		numtokens--;
+		return;
+	}
+
+	token->next = freetokens;
+	freetokens = token;
 	numtokens--;
 }
 
+/*
+===============
+Parse_ReleaseTokenBlocks
+
+Gives the token blocks back once every token has been freed
+===============
+*/
+static void Parse_ReleaseTokenBlocks()
+{
+	if ( numtokens )
+	{
+		return;
+	}
+
+	while ( tokenblocks )
+	{
+		tokenBlock_t *block = tokenblocks;
+
+		tokenblocks = block->next;
+		BG_Free( block );
+	}
+
+	freetokens = nullptr;
+}
+
+/*
+===============
+Parse_SetReferenceTokens
+
+Switches between pooled tokens and the one by one allocation they
+replaced. Only possible while no token is in use, since each path frees
+its own tokens.
+===============
+*/
+bool Parse_SetReferenceTokens( bool enable )
+{
+	if ( numtokens )
+	{
+		return false;
+	}
+
+	Parse_ReleaseTokenBlocks();
+	tokenreference = enable;
+	return true;
+}
+
 static void Parse_FreeTokens(token_t *firsttoken)
 {
 	token_t *t, *nexttoken;
@@ -1431,7 +1586,7 @@ static int Parse_ReadSourceToken( source_t *source, token_t *token )
 	}
 
 	//copy the already available token
-	memcpy( token, source->tokens, sizeof( token_t ) );
+	Parse_AssignToken( token, source->tokens );
 	//free the read token
 	t = source->tokens;
 	source->tokens = source->tokens->next;
@@ -3865,7 +4020,7 @@ static bool Parse_ReadToken( source_t *source, token_t *token )
 		}
 
 		//copy token for unreading
-		memcpy( &source->token, token, sizeof( token_t ) );
+		Parse_AssignToken( &source->token, token );
 		//found a token
 		return true;
 	}
@@ -4008,6 +4163,7 @@ void Parse_FreeGlobalDefines()
 		Parse_FreeDefine( define );
 	}
 	globaldefines = nullptr;
+	Parse_ReleaseTokenBlocks();
 }
 
 /*
@@ -4220,6 +4376,7 @@ int Parse_FreeSourceHandle( int handle )
 
 	Parse_FreeSource( sourceFiles[ handle ] );
 	sourceFiles[ handle ] = nullptr;
+	Parse_ReleaseTokenBlocks();
 	return true;
 }
 
@@ -54,6 +54,7 @@ int Parse_LoadSourceHandle(const char *filename, int (*openFunc)(Str::StringRef,
 int Parse_FreeSourceHandle(int handle);
 bool Parse_ReadTokenHandle(int handle, pc_token_t *pc_token);
 int Parse_SourceFileAndLine(int handle, char (&filename)[MAX_QPATH], int *line);
+bool Parse_SetReferenceTokens(bool enable);
 
 /*
 ===============